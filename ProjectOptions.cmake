@@ -1,4 +1,6 @@
 option(ENABLE_SANITIZERS "Enable asan and ubsan" OFF)
 option(ENABLE_CLANG_TIDY "Enable clang-tidy analysis" ON)
 option(BUILD_DOXYGEN "Build doxygen" ON)
-option(BUILD_TESTS "Build tests" ON)
\ No newline at end of file
+option(BUILD_TESTS "Build tests" ON)
+option(BUILD_BENCHMARKS "Build benchmarks" OFF)
+option(ENABLE_TSAN "Build the stress tests with ThreadSanitizer" OFF)
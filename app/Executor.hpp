@@ -0,0 +1,202 @@
+#ifndef EXECUTOR_HPP
+#define EXECUTOR_HPP
+
+#include "ContainerQueue/TimeoutQueue.hpp"
+#include "ContainerQueue/Traits.hpp"
+#include "ContainerQueue/WorkStealingDeque.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace fcp
+{
+
+/**
+ * @brief A unit of work for the Executor: a function pointer and a context, identified by a unique ID.
+ *
+ * Tasks are owned by the caller and must stay alive until they have run. A task may be submitted again once it has
+ * started running.
+ */
+class Task
+{
+  public:
+    using Function = void (*)(Task &);
+
+    Task(uint16_t id, Function function, void *context = nullptr) : id_{id}, function_{function}, context_{context}
+    {
+    }
+
+    uint16_t GetId() const
+    {
+        return id_;
+    }
+
+    void *context() const
+    {
+        return context_;
+    }
+
+    void run()
+    {
+        function_(*this);
+    }
+
+  private:
+    uint16_t id_;
+    Function function_;
+    void *context_;
+};
+
+/**
+ * @brief A fixed-size thread pool that schedules tasks through per-worker work-stealing deques.
+ *
+ * - Tasks submitted from inside a running task go to the calling worker's own `WorkStealingDeque`, which it pops in
+ *   LIFO order, so freshly spawned work runs while its data is still in cache and no lock is taken.
+ * - Workers whose deque is empty steal the oldest task of the other workers, visiting them round-robin.
+ * - Tasks submitted from other threads, and tasks that do not fit into a full deque, go to a shared `TimeoutQueue`.
+ *   Its ID range bounds the task IDs that can be submitted from outside (`InjectorCapacity`).
+ * - Idle workers block on the shared queue for up to `kIdleWaitUs` before they look at the deques again.
+ *
+ * The destructor waits until every submitted task, including the ones those tasks submit, has run.
+ *
+ * @tparam Workers          Number of worker threads.
+ * @tparam DequeCapacity    Capacity of each worker's deque.
+ * @tparam InjectorCapacity ID range of the shared queue for external submissions.
+ */
+template <std::size_t Workers, std::size_t DequeCapacity = 256, std::size_t InjectorCapacity = 1024> class Executor
+{
+    static_assert(Workers > 0, "Executor requires at least one worker");
+
+    using Status = Queue::Status;
+
+  public:
+    /// How long an idle worker blocks on the shared queue before it tries to steal again.
+    static constexpr long kIdleWaitUs{1000};
+
+    /// Per-worker counters, readable while the executor runs.
+    struct WorkerStats
+    {
+        std::size_t executed;
+        std::size_t stolen;
+    };
+
+    Executor()
+    {
+        for (std::size_t i = 0; i < Workers; ++i)
+        {
+            workers_[i].owner = this;
+            workers_[i].index = i;
+            threads_[i] = std::thread([this, i] { run(workers_[i]); });
+        }
+    }
+
+    ~Executor()
+    {
+        stopping_.store(true, std::memory_order_release);
+        for (auto &thread : threads_)
+        {
+            thread.join();
+        }
+    }
+
+    Executor(const Executor &) = delete;
+    Executor &operator=(const Executor &) = delete;
+
+    Executor(Executor &&) = delete;
+    Executor &operator=(Executor &&) = delete;
+
+    /**
+     * @brief Schedules a task. May be called from any thread, including from inside a running task.
+     *
+     * @return Status::Ok, or the status of the shared queue push (e.g. Status::InvalidId or Status::Duplicate) when
+     *         the task could not be placed on a worker deque.
+     */
+    Status submit(Task &task)
+    {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        if (current_ != nullptr && current_->owner == this && current_->deque.push(&task) == Status::Ok)
+        {
+            return Status::Ok;
+        }
+        auto const status = injector_.push(task);
+        if (status != Status::Ok)
+        {
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return status;
+    }
+
+    /**
+     * @brief Returns the number of submitted tasks that have not finished yet.
+     */
+    std::size_t pending() const
+    {
+        return pending_.load(std::memory_order_acquire);
+    }
+
+    WorkerStats stats(std::size_t worker) const
+    {
+        auto const &w = workers_[worker];
+        return {w.executed.load(std::memory_order_relaxed), w.stolen.load(std::memory_order_relaxed)};
+    }
+
+  private:
+    struct alignas(kCacheLineSize) Worker
+    {
+        WorkStealingDeque<Task *, DequeCapacity> deque;
+        std::atomic<std::size_t> executed{0};
+        std::atomic<std::size_t> stolen{0};
+        Executor *owner{nullptr};
+        std::size_t index{0};
+    };
+
+    void run(Worker &self)
+    {
+        current_ = &self;
+        while (true)
+        {
+            Task *task = nullptr;
+            if (self.deque.pop(task) == Status::Ok || steal(self, task) ||
+                injector_.pop(task, kIdleWaitUs) == Status::Ok)
+            {
+                task->run();
+                self.executed.fetch_add(1, std::memory_order_relaxed);
+                pending_.fetch_sub(1, std::memory_order_acq_rel);
+                continue;
+            }
+            if (stopping_.load(std::memory_order_acquire) && pending_.load(std::memory_order_acquire) == 0)
+            {
+                break;
+            }
+        }
+        current_ = nullptr;
+    }
+
+    bool steal(Worker &self, Task *&task)
+    {
+        for (std::size_t k = 1; k < Workers; ++k)
+        {
+            if (workers_[(self.index + k) % Workers].deque.steal(task) == Status::Ok)
+            {
+                self.stolen.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // The worker running on the calling thread, if any
+    static inline thread_local Worker *current_{nullptr};
+
+    std::array<Worker, Workers> workers_;
+    PolicyTimeoutQueue<Task, StdLockPolicy, InjectorCapacity> injector_;
+    alignas(kCacheLineSize) std::atomic<std::size_t> pending_{0};
+    std::atomic<bool> stopping_{false};
+    std::array<std::thread, Workers> threads_;
+};
+
+} // namespace fcp
+
+#endif // EXECUTOR_HPP
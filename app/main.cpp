@@ -0,0 +1,91 @@
+#include "Executor.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// Reference use of the executor: a few tasks are submitted from the main thread, and each of them fans out into
+// child tasks from inside the pool, which the other workers steal.
+
+namespace
+{
+
+constexpr std::size_t kWorkers = 4;
+constexpr uint16_t kRoots = 8;
+constexpr uint16_t kChildrenPerRoot = 64;
+
+struct Workload
+{
+    fcp::Executor<kWorkers> *executor{nullptr};
+    std::vector<fcp::Task> tasks;
+    std::atomic<uint64_t> checksum{0};
+};
+
+void child(fcp::Task &task)
+{
+    auto &work = *static_cast<Workload *>(task.context());
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < 100000; ++i)
+    {
+        sum += (i * task.GetId()) % 7;
+    }
+    work.checksum.fetch_add(sum, std::memory_order_relaxed);
+}
+
+void root(fcp::Task &task)
+{
+    auto &work = *static_cast<Workload *>(task.context());
+    auto const first = kRoots + task.GetId() * kChildrenPerRoot;
+    for (uint16_t i = 0; i < kChildrenPerRoot; ++i)
+    {
+        work.executor->submit(work.tasks[first + i]);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    Workload work;
+    work.tasks.reserve(kRoots + kRoots * kChildrenPerRoot);
+    for (uint16_t id = 0; id < kRoots; ++id)
+    {
+        work.tasks.emplace_back(id, root, &work);
+    }
+    for (uint16_t id = kRoots; id < kRoots + kRoots * kChildrenPerRoot; ++id)
+    {
+        work.tasks.emplace_back(id, child, &work);
+    }
+
+    std::size_t executed[kWorkers] = {};
+    std::size_t stolen[kWorkers] = {};
+    {
+        fcp::Executor<kWorkers> executor;
+        work.executor = &executor;
+        for (uint16_t id = 0; id < kRoots; ++id)
+        {
+            if (executor.submit(work.tasks[id]) != fcp::Queue::Status::Ok)
+            {
+                std::fprintf(stderr, "failed to submit task %u\n", static_cast<unsigned>(id));
+                return 1;
+            }
+        }
+        while (executor.pending() > 0)
+        {
+            std::this_thread::yield();
+        }
+        for (std::size_t w = 0; w < kWorkers; ++w)
+        {
+            executed[w] = executor.stats(w).executed;
+            stolen[w] = executor.stats(w).stolen;
+        }
+    }
+
+    for (std::size_t w = 0; w < kWorkers; ++w)
+    {
+        std::printf("worker %zu: executed %zu, stolen %zu\n", w, executed[w], stolen[w]);
+    }
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(work.checksum.load()));
+    return 0;
+}
@@ -0,0 +1,121 @@
+#ifndef BENCH_COMMON_HPP
+#define BENCH_COMMON_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace bench
+{
+
+/**
+ * @brief Queue element of `Size` bytes carrying its ID, so element size can be varied independently of the queue.
+ */
+template <std::size_t Size> class Item
+{
+    static_assert(Size >= sizeof(uint16_t), "Item must be large enough to hold its ID");
+
+  public:
+    constexpr Item() = default;
+    constexpr explicit Item(uint16_t id) : id_{id}
+    {
+    }
+    constexpr uint16_t GetId() const
+    {
+        return id_;
+    }
+
+  private:
+    uint16_t id_{0};
+    std::array<std::byte, Size - sizeof(uint16_t)> payload_{};
+};
+
+/**
+ * @brief Creates `n` items with IDs `0 .. n - 1`.
+ */
+template <typename T> std::vector<T> MakeItems(std::size_t n)
+{
+    std::vector<T> items;
+    items.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        items.emplace_back(static_cast<uint16_t>(i));
+    }
+    return items;
+}
+
+/**
+ * @brief Returns the IDs `0 .. n - 1` in a fixed pseudo-random order.
+ */
+inline std::vector<uint16_t> ShuffledIds(std::size_t n)
+{
+    std::vector<uint16_t> ids(n);
+    std::iota(ids.begin(), ids.end(), uint16_t{0});
+    std::shuffle(ids.begin(), ids.end(), std::mt19937{42});
+    return ids;
+}
+
+struct MutexTrait
+{
+    static void init(std::mutex &)
+    {
+    }
+    static void lock(std::mutex &mtx)
+    {
+        mtx.lock();
+    }
+    static void unlock(std::mutex &mtx)
+    {
+        mtx.unlock();
+    }
+};
+
+// Entered and left with the mutex held, as TimeoutQueue expects; it is only released while blocked.
+struct SemaphoreTrait
+{
+    static void init(std::condition_variable &)
+    {
+    }
+
+    template <typename Predicate>
+    static bool wait(std::condition_variable &cv, std::mutex &mtx, Predicate pred, long timeout_us = 0)
+    {
+        std::unique_lock<std::mutex> lock(mtx, std::adopt_lock);
+        bool ok = true;
+        if (timeout_us < 0)
+        {
+            cv.wait(lock, pred);
+        }
+        else if (timeout_us == 0)
+        {
+            ok = pred();
+        }
+        else
+        {
+            ok = cv.wait_for(lock, std::chrono::microseconds(timeout_us), pred);
+        }
+        lock.release();
+        return ok;
+    }
+
+    static void notify(std::condition_variable &cv)
+    {
+        cv.notify_one();
+    }
+
+    static void notify_all(std::condition_variable &cv)
+    {
+        cv.notify_all();
+    }
+};
+
+} // namespace bench
+
+#endif // BENCH_COMMON_HPP
@@ -0,0 +1,122 @@
+#include "BenchCommon.hpp"
+#include "ContainerQueue/Platform.hpp"
+#include "ContainerQueue/TimeoutQueue.hpp"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+using bench::Item;
+
+namespace
+{
+
+// TimeoutQueue's header fields declared back to back, as before they were split across cache lines
+struct PackedHeader
+{
+    std::atomic<std::size_t> size{0};
+    std::size_t waiters{0};
+    uint16_t head{0};
+    uint16_t tail{0};
+    std::mutex mutex;
+    std::condition_variable semaphore;
+};
+
+// The same fields grouped the way TimeoutQueue lays them out now
+struct AlignedHeader
+{
+    alignas(fcp::kCacheLineSize) std::atomic<std::size_t> size{0};
+    std::size_t waiters{0};
+    uint16_t head{0};
+    uint16_t tail{0};
+    alignas(fcp::kCacheLineSize) std::mutex mutex;
+    alignas(fcp::kCacheLineSize) std::condition_variable semaphore;
+};
+
+// Thread 0 takes the lock and updates the list header like push/pop do, the other threads poll the size like
+// monitoring threads calling size(). With the packed layout every lock/unlock invalidates the pollers' line.
+template <typename Header> void BM_HeaderFalseSharing(benchmark::State &state)
+{
+    static Header header;
+    int64_t ops = 0;
+    if (state.thread_index() == 0)
+    {
+        for (auto _ : state)
+        {
+            header.mutex.lock();
+            header.head++;
+            header.tail++;
+            header.size.store(header.size.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            header.mutex.unlock();
+            ++ops;
+        }
+    }
+    else
+    {
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(header.size.load(std::memory_order_relaxed));
+            ++ops;
+        }
+    }
+    state.SetItemsProcessed(ops);
+}
+
+constexpr std::size_t kCapacity = 4096;
+
+using BenchTimeoutQueue = fcp::TimeoutQueue<Item<8>, std::mutex, std::condition_variable, bench::MutexTrait,
+                                            bench::SemaphoreTrait, kCapacity>;
+
+// Even threads push and pop, odd threads poll size(), empty() and full() as health checks do.
+void BM_TimeoutQueue_ObservedPushPop(benchmark::State &state)
+{
+    static BenchTimeoutQueue *q = nullptr;
+    static std::vector<Item<8>> items;
+    if (state.thread_index() == 0)
+    {
+        items = bench::MakeItems<Item<8>>(kCapacity);
+        q = new BenchTimeoutQueue();
+    }
+
+    int64_t ops = 0;
+    if (state.thread_index() % 2 == 0)
+    {
+        auto const base = static_cast<std::size_t>(state.thread_index()) * 64;
+        std::size_t next = 0;
+        Item<8> *out = nullptr;
+        for (auto _ : state)
+        {
+            q->push(items[base + next]);
+            next = (next + 1) % 64;
+            q->pop(out);
+            benchmark::DoNotOptimize(out);
+            ops += 2;
+        }
+    }
+    else
+    {
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(q->size());
+            benchmark::DoNotOptimize(q->empty());
+            benchmark::DoNotOptimize(q->full());
+            ++ops;
+        }
+    }
+    state.SetItemsProcessed(ops);
+
+    if (state.thread_index() == 0)
+    {
+        delete q;
+        q = nullptr;
+    }
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_HeaderFalseSharing, PackedHeader)->ThreadRange(2, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_HeaderFalseSharing, AlignedHeader)->ThreadRange(2, 16)->UseRealTime();
+
+BENCHMARK(BM_TimeoutQueue_ObservedPushPop)->ThreadRange(2, 32)->UseRealTime();
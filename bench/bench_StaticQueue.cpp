@@ -0,0 +1,62 @@
+#include "BenchCommon.hpp"
+#include "ContainerQueue/StaticQueue.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <span>
+#include <vector>
+
+using bench::Item;
+using fcp::StaticQueue;
+
+namespace
+{
+
+// One push followed by one pop on a half-full queue, so the cursors keep wrapping.
+template <std::size_t Size, std::size_t Capacity> void BM_StaticQueue_PushPop(benchmark::State &state)
+{
+    auto q = std::make_unique<StaticQueue<Item<Size>, Capacity>>();
+    for (std::size_t i = 0; i < Capacity / 2; ++i)
+    {
+        q->push(Item<Size>{static_cast<uint16_t>(i)});
+    }
+    Item<Size> in{1};
+    Item<Size> out{};
+    for (auto _ : state)
+    {
+        q->push(in);
+        q->pop(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * Size);
+}
+
+// Fills the queue completely with `push_n` and drains it with `pop_n`.
+template <std::size_t Size, std::size_t Capacity> void BM_StaticQueue_Batch(benchmark::State &state)
+{
+    auto q = std::make_unique<StaticQueue<Item<Size>, Capacity>>();
+    auto const in = bench::MakeItems<Item<Size>>(Capacity);
+    std::vector<Item<Size>> out(Capacity);
+    for (auto _ : state)
+    {
+        q->push_n(std::span<Item<Size> const>(in));
+        q->pop_n(std::span<Item<Size>>(out));
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * Capacity);
+    state.SetBytesProcessed(state.iterations() * Capacity * Size);
+}
+
+} // namespace
+
+// Power-of-two and non-power-of-two capacities take different index paths
+BENCHMARK_TEMPLATE(BM_StaticQueue_PushPop, 8, 64);
+BENCHMARK_TEMPLATE(BM_StaticQueue_PushPop, 8, 1000);
+BENCHMARK_TEMPLATE(BM_StaticQueue_PushPop, 8, 1024);
+BENCHMARK_TEMPLATE(BM_StaticQueue_PushPop, 64, 1024);
+BENCHMARK_TEMPLATE(BM_StaticQueue_PushPop, 256, 1024);
+
+BENCHMARK_TEMPLATE(BM_StaticQueue_Batch, 8, 64);
+BENCHMARK_TEMPLATE(BM_StaticQueue_Batch, 8, 1024);
+BENCHMARK_TEMPLATE(BM_StaticQueue_Batch, 64, 1024);
+BENCHMARK_TEMPLATE(BM_StaticQueue_Batch, 256, 1024);
@@ -0,0 +1,176 @@
+#include "BenchCommon.hpp"
+#include "ContainerQueue/ShardedTimeoutQueue.hpp"
+#include "ContainerQueue/TimeoutQueue.hpp"
+#include <benchmark/benchmark.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using bench::Item;
+
+namespace
+{
+
+template <std::size_t Size, std::size_t Capacity>
+using BenchTimeoutQueue = fcp::TimeoutQueue<Item<Size>, std::mutex, std::condition_variable, bench::MutexTrait,
+                                            bench::SemaphoreTrait, Capacity>;
+
+template <std::size_t Size, std::size_t Capacity> void BM_TimeoutQueue_PushPop(benchmark::State &state)
+{
+    auto q = std::make_unique<BenchTimeoutQueue<Size, Capacity>>();
+    auto items = bench::MakeItems<Item<Size>>(Capacity);
+    Item<Size> *out = nullptr;
+    for (auto _ : state)
+    {
+        for (auto &item : items)
+        {
+            q->push(item);
+        }
+        while (q->pop(out) == fcp::Queue::Status::Ok)
+        {
+            benchmark::DoNotOptimize(out);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * Capacity);
+}
+
+template <std::size_t Size, std::size_t Capacity> void BM_TimeoutQueue_RandomRemove(benchmark::State &state)
+{
+    auto q = std::make_unique<BenchTimeoutQueue<Size, Capacity>>();
+    auto items = bench::MakeItems<Item<Size>>(Capacity);
+    auto const ids = bench::ShuffledIds(Capacity);
+    for (auto _ : state)
+    {
+        for (auto &item : items)
+        {
+            q->push(item);
+        }
+        for (auto id : ids)
+        {
+            benchmark::DoNotOptimize(q->remove(items[id]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * Capacity);
+}
+
+template <std::size_t Size, std::size_t Capacity> void BM_TimeoutQueue_Front(benchmark::State &state)
+{
+    auto q = std::make_unique<BenchTimeoutQueue<Size, Capacity>>();
+    auto items = bench::MakeItems<Item<Size>>(Capacity);
+    for (auto &item : items)
+    {
+        q->push(item);
+    }
+    Item<Size> *out = nullptr;
+    for (auto _ : state)
+    {
+        q->front(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+constexpr std::size_t kContendedCapacity = 4096;
+constexpr std::size_t kIdsPerThread = kContendedCapacity / 64;
+
+// Every thread pushes from its own ID range and pops whatever is at the front, so all threads fight over one lock.
+template <std::size_t Size> void BM_TimeoutQueue_Contended(benchmark::State &state)
+{
+    static BenchTimeoutQueue<Size, kContendedCapacity> *q = nullptr;
+    static std::vector<Item<Size>> items;
+    if (state.thread_index() == 0)
+    {
+        items = bench::MakeItems<Item<Size>>(kContendedCapacity);
+        q = new BenchTimeoutQueue<Size, kContendedCapacity>();
+    }
+
+    auto const base = static_cast<std::size_t>(state.thread_index()) * kIdsPerThread;
+    std::size_t next = 0;
+    int64_t ops = 0;
+    Item<Size> *out = nullptr;
+    for (auto _ : state)
+    {
+        if (q->push(items[base + next]) == fcp::Queue::Status::Ok)
+        {
+            ++ops;
+        }
+        next = (next + 1) % kIdsPerThread;
+        if (q->pop(out) == fcp::Queue::Status::Ok)
+        {
+            ++ops;
+        }
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(ops);
+
+    if (state.thread_index() == 0)
+    {
+        delete q;
+        q = nullptr;
+    }
+}
+
+template <std::size_t Size, std::size_t Shards>
+using BenchShardedQueue = fcp::ShardedTimeoutQueue<Item<Size>, std::mutex, std::condition_variable,
+                                                   bench::MutexTrait, bench::SemaphoreTrait, Shards,
+                                                   kContendedCapacity>;
+
+// Same load as BM_TimeoutQueue_Contended, with each thread's ID range and home shard falling on the same shard.
+template <std::size_t Size, std::size_t Shards> void BM_ShardedTimeoutQueue_Contended(benchmark::State &state)
+{
+    static BenchShardedQueue<Size, Shards> *q = nullptr;
+    static std::vector<Item<Size>> items;
+    if (state.thread_index() == 0)
+    {
+        items = bench::MakeItems<Item<Size>>(kContendedCapacity);
+        q = new BenchShardedQueue<Size, Shards>();
+    }
+
+    auto const base = static_cast<std::size_t>(state.thread_index()) * kIdsPerThread;
+    auto const home = BenchShardedQueue<Size, Shards>::shard_of(static_cast<uint16_t>(base));
+    std::size_t next = 0;
+    int64_t ops = 0;
+    Item<Size> *out = nullptr;
+    for (auto _ : state)
+    {
+        if (q->push(items[base + next]) == fcp::Queue::Status::Ok)
+        {
+            ++ops;
+        }
+        next = (next + 1) % kIdsPerThread;
+        if (q->pop(out, 0, home) == fcp::Queue::Status::Ok)
+        {
+            ++ops;
+        }
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(ops);
+
+    if (state.thread_index() == 0)
+    {
+        delete q;
+        q = nullptr;
+    }
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_TimeoutQueue_PushPop, 8, 64);
+BENCHMARK_TEMPLATE(BM_TimeoutQueue_PushPop, 8, 4096);
+BENCHMARK_TEMPLATE(BM_TimeoutQueue_PushPop, 256, 4096);
+BENCHMARK_TEMPLATE(BM_TimeoutQueue_PushPop, 8, 65535);
+
+BENCHMARK_TEMPLATE(BM_TimeoutQueue_RandomRemove, 8, 64);
+BENCHMARK_TEMPLATE(BM_TimeoutQueue_RandomRemove, 8, 4096);
+BENCHMARK_TEMPLATE(BM_TimeoutQueue_RandomRemove, 256, 4096);
+BENCHMARK_TEMPLATE(BM_TimeoutQueue_RandomRemove, 8, 65535);
+
+BENCHMARK_TEMPLATE(BM_TimeoutQueue_Front, 8, 64);
+BENCHMARK_TEMPLATE(BM_TimeoutQueue_Front, 256, 4096);
+
+BENCHMARK_TEMPLATE(BM_TimeoutQueue_Contended, 8)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_TimeoutQueue_Contended, 256)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_ShardedTimeoutQueue_Contended, 8, 8)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ShardedTimeoutQueue_Contended, 8, 64)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,124 @@
+#include "BenchCommon.hpp"
+#include "ContainerQueue/IntrusiveQueue.hpp"
+#include "ContainerQueue/UniqueIdQueue.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+using bench::Item;
+using fcp::NodeLayout;
+using fcp::UniqueIdQueue;
+
+namespace
+{
+
+// Fills the queue to capacity and drains it again in FIFO order.
+template <std::size_t Size, std::size_t Capacity, NodeLayout Layout>
+void BM_UniqueIdQueue_PushPop(benchmark::State &state)
+{
+    auto q = std::make_unique<UniqueIdQueue<Item<Size>, Capacity, Layout>>(Capacity);
+    auto items = bench::MakeItems<Item<Size>>(Capacity);
+    Item<Size> *out = nullptr;
+    for (auto _ : state)
+    {
+        for (auto &item : items)
+        {
+            q->push(item);
+        }
+        while (q->pop(out) == fcp::Queue::Status::Ok)
+        {
+            benchmark::DoNotOptimize(out);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * Capacity);
+}
+
+// Fills the queue and removes every element by ID in random order, which defeats the prefetcher on the node table.
+template <std::size_t Size, std::size_t Capacity, NodeLayout Layout>
+void BM_UniqueIdQueue_RandomRemove(benchmark::State &state)
+{
+    auto q = std::make_unique<UniqueIdQueue<Item<Size>, Capacity, Layout>>(Capacity);
+    auto items = bench::MakeItems<Item<Size>>(Capacity);
+    auto const ids = bench::ShuffledIds(Capacity);
+    for (auto _ : state)
+    {
+        for (auto &item : items)
+        {
+            q->push(item);
+        }
+        for (auto id : ids)
+        {
+            benchmark::DoNotOptimize(q->remove(id));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * Capacity);
+}
+
+template <std::size_t Size, std::size_t Capacity, NodeLayout Layout>
+void BM_UniqueIdQueue_Front(benchmark::State &state)
+{
+    auto q = std::make_unique<UniqueIdQueue<Item<Size>, Capacity, Layout>>(Capacity);
+    auto items = bench::MakeItems<Item<Size>>(Capacity);
+    for (auto &item : items)
+    {
+        q->push(item);
+    }
+    Item<Size> *out = nullptr;
+    for (auto _ : state)
+    {
+        q->front(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Element of `Size` bytes carrying the links of an IntrusiveQueue instead of an ID
+template <std::size_t Size> struct HookedItem
+{
+    fcp::QueueHook<HookedItem> hook;
+    std::array<std::byte, Size> payload{};
+};
+
+template <std::size_t Size> using HookedQueue = fcp::IntrusiveQueue<HookedItem<Size>, &HookedItem<Size>::hook>;
+
+// Same workload as BM_UniqueIdQueue_RandomRemove without the ID-indexed side table
+template <std::size_t Size, std::size_t Count> void BM_IntrusiveQueue_RandomRemove(benchmark::State &state)
+{
+    HookedQueue<Size> q;
+    std::vector<HookedItem<Size>> items(Count);
+    auto const ids = bench::ShuffledIds(Count);
+    for (auto _ : state)
+    {
+        for (auto &item : items)
+        {
+            q.push(item);
+        }
+        for (auto id : ids)
+        {
+            benchmark::DoNotOptimize(q.remove(items[id]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * Count);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_UniqueIdQueue_PushPop, 8, 64, NodeLayout::Interleaved);
+BENCHMARK_TEMPLATE(BM_UniqueIdQueue_PushPop, 8, 4096, NodeLayout::Interleaved);
+BENCHMARK_TEMPLATE(BM_UniqueIdQueue_PushPop, 8, 4096, NodeLayout::Split);
+BENCHMARK_TEMPLATE(BM_UniqueIdQueue_PushPop, 256, 4096, NodeLayout::Interleaved);
+BENCHMARK_TEMPLATE(BM_UniqueIdQueue_PushPop, 8, 65535, NodeLayout::Interleaved);
+
+BENCHMARK_TEMPLATE(BM_UniqueIdQueue_RandomRemove, 8, 64, NodeLayout::Interleaved);
+BENCHMARK_TEMPLATE(BM_UniqueIdQueue_RandomRemove, 8, 4096, NodeLayout::Interleaved);
+BENCHMARK_TEMPLATE(BM_UniqueIdQueue_RandomRemove, 8, 4096, NodeLayout::Split);
+BENCHMARK_TEMPLATE(BM_UniqueIdQueue_RandomRemove, 256, 4096, NodeLayout::Interleaved);
+BENCHMARK_TEMPLATE(BM_UniqueIdQueue_RandomRemove, 8, 65535, NodeLayout::Interleaved);
+BENCHMARK_TEMPLATE(BM_UniqueIdQueue_RandomRemove, 8, 65535, NodeLayout::Split);
+
+BENCHMARK_TEMPLATE(BM_UniqueIdQueue_Front, 8, 64, NodeLayout::Interleaved);
+BENCHMARK_TEMPLATE(BM_UniqueIdQueue_Front, 256, 4096, NodeLayout::Interleaved);
+
+BENCHMARK_TEMPLATE(BM_IntrusiveQueue_RandomRemove, 8, 4096);
+BENCHMARK_TEMPLATE(BM_IntrusiveQueue_RandomRemove, 256, 4096);
+BENCHMARK_TEMPLATE(BM_IntrusiveQueue_RandomRemove, 8, 65535);
@@ -0,0 +1,199 @@
+#ifndef BROADCAST_QUEUE_HPP
+#define BROADCAST_QUEUE_HPP
+
+#include "Platform.hpp"
+#include "Queue.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+namespace fcp
+{
+
+/**
+ * @brief A fixed-capacity, lock-free single-producer ring in which every reader sees every element.
+ *
+ * BroadcastQueue is a disruptor-style fan-out ring: one copy of each element serves `Readers` consumers.
+ * - One write cursor: The producer publishes elements by advancing a single sequence with release ordering.
+ * - Per-reader cursors: Reader `r` owns cursor `r` on its own cache line and advances it independently, so readers
+ *   never contend with each other.
+ * - The slowest reader gates the producer: A slot is only reused once every reader has moved past it. The producer
+ *   caches the minimum reader cursor and only rescans the cursors when the ring looks full.
+ * - Batch reads: `consume()` visits everything up to the latest published sequence in place and releases the whole
+ *   batch with a single store.
+ * - No dynamic memory allocation: All storage is preallocated based on the specified capacity.
+ *
+ * @tparam T        The type of elements stored in the queue. Must be default-constructible and copy-assignable.
+ * @tparam Capacity Maximum number of elements a reader can lag behind the producer.
+ * @tparam Readers  Number of readers; each uses a fixed index in `0 .. Readers - 1`.
+ */
+template <typename T, std::size_t Capacity, std::size_t Readers> class BroadcastQueue : public Queue
+{
+    static_assert(Capacity > 0, "BroadcastQueue requires a Capacity greater than zero");
+    static_assert(Readers > 0, "BroadcastQueue requires at least one reader");
+
+    using Status = Queue::Status;
+
+  public:
+    BroadcastQueue() = default;
+    ~BroadcastQueue() = default;
+
+    BroadcastQueue(const BroadcastQueue &) = delete;
+    BroadcastQueue &operator=(const BroadcastQueue &) = delete;
+
+    BroadcastQueue(BroadcastQueue &&) = delete;
+    BroadcastQueue &operator=(BroadcastQueue &&) = delete;
+
+    /**
+     * @brief Publishes an element to all readers. Must only be called from the producer thread.
+     *
+     * @return Status::Ok on success, Status::Full if the slowest reader is `Capacity` elements behind.
+     */
+    Status push(T const &element)
+    {
+        return push_n(std::span<T const>(&element, 1)) == 1 ? Status::Ok : Status::Full;
+    }
+
+    /**
+     * @brief Publishes as many elements of the range as the slowest reader allows, with a single release store.
+     *
+     * @return Number of elements published.
+     */
+    std::size_t push_n(std::span<T const> elements)
+    {
+        auto const tail = published_.load(std::memory_order_relaxed);
+        if (tail - gate_cache_ + elements.size() > Capacity)
+        {
+            gate_cache_ = slowest();
+        }
+        auto const n = std::min<std::size_t>(elements.size(), Capacity - (tail - gate_cache_));
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            data_[(tail + i) % Capacity] = elements[i];
+        }
+        if (n > 0)
+        {
+            published_.store(tail + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    /**
+     * @brief Copies the next element for `reader` and advances its cursor. Must only be called by that reader.
+     *
+     * @return Status::Ok on success, Status::Empty if the reader has seen every published element.
+     */
+    Status pop(std::size_t reader, T &out)
+    {
+        auto &cursor = cursors_[reader].next;
+        auto const next = cursor.load(std::memory_order_relaxed);
+        if (next == published_.load(std::memory_order_acquire))
+        {
+            return Status::Empty;
+        }
+        out = data_[next % Capacity];
+        cursor.store(next + 1, std::memory_order_release);
+        return Status::Ok;
+    }
+
+    /**
+     * @brief Visits every element published since the last read of `reader`, then releases them all at once.
+     *
+     * The visitor is called as `visitor(T const &)` on the slots themselves, in publication order; the producer cannot
+     * overwrite them until `consume()` returns. Must only be called by that reader.
+     *
+     * @param reader Index of the calling reader.
+     * @param visitor Callable invoked for each element.
+     * @param limit Maximum number of elements to visit.
+     * @return Number of elements visited.
+     */
+    template <typename Visitor>
+    std::size_t consume(std::size_t reader, Visitor &&visitor,
+                        std::size_t limit = std::numeric_limits<std::size_t>::max())
+    {
+        auto &cursor = cursors_[reader].next;
+        auto const next = cursor.load(std::memory_order_relaxed);
+        auto const available = published_.load(std::memory_order_acquire) - next;
+        auto const n = static_cast<std::size_t>(std::min<uint64_t>(available, limit));
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            visitor(static_cast<T const &>(data_[(next + i) % Capacity]));
+        }
+        if (n > 0)
+        {
+            cursor.store(next + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    /**
+     * @brief Returns how many published elements `reader` has not read yet; possibly stale when called concurrently.
+     */
+    std::size_t size(std::size_t reader) const
+    {
+        auto const next = cursors_[reader].next.load(std::memory_order_acquire);
+        return static_cast<std::size_t>(published_.load(std::memory_order_acquire) - next);
+    }
+
+    /**
+     * @brief Returns the lag of the slowest reader, i.e. the number of occupied slots.
+     *
+     * The cursors are read before the published sequence, so the producer may have refilled the slots freed in
+     * between; the result is clamped to `Capacity`.
+     */
+    std::size_t size() const
+    {
+        auto const gate = slowest();
+        return static_cast<std::size_t>(
+            std::min<uint64_t>(published_.load(std::memory_order_acquire) - gate, Capacity));
+    }
+
+    bool full() const
+    {
+        return size() == Capacity;
+    }
+
+    bool empty(std::size_t reader) const
+    {
+        return size(reader) == 0;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+  private:
+    // Sequence of the next element reader `r` reads, written only by that reader.
+    struct alignas(kCacheLineSize) Cursor
+    {
+        std::atomic<uint64_t> next{0};
+    };
+
+    uint64_t slowest() const
+    {
+        auto gate = std::numeric_limits<uint64_t>::max();
+        for (auto const &cursor : cursors_)
+        {
+            gate = std::min(gate, cursor.next.load(std::memory_order_acquire));
+        }
+        return gate;
+    }
+
+    // Written by the producer, read by every reader.
+    alignas(kCacheLineSize) std::atomic<uint64_t> published_{0};
+    // Producer-local copy of the slowest reader cursor, kept off the line the readers poll.
+    alignas(kCacheLineSize) uint64_t gate_cache_{0};
+
+    std::array<Cursor, Readers> cursors_;
+
+    alignas(kCacheLineSize) std::array<T, Capacity> data_{};
+};
+
+} // namespace fcp
+
+#endif // BROADCAST_QUEUE_HPP
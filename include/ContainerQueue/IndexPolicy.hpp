@@ -0,0 +1,187 @@
+#ifndef INDEX_POLICY_HPP
+#define INDEX_POLICY_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace fcp
+{
+
+/**
+ * @brief Smallest unsigned type that can link every ID of a queue with the given capacity.
+ *
+ * The maximum value of the selected type is reserved as the "no node" link, so IDs `0 .. Capacity - 1` always fit.
+ *
+ * @tparam Capacity Number of distinct IDs the queue has to address.
+ */
+template <std::size_t Capacity>
+using LinkIndex = std::conditional_t<
+    (Capacity <= std::numeric_limits<uint8_t>::max()), uint8_t,
+    std::conditional_t<(Capacity <= std::numeric_limits<uint16_t>::max()), uint16_t, uint32_t>>;
+
+/**
+ * @brief Default key trait of the ID-indexed queues: an element is identified by its `GetId()` method.
+ *
+ * A key trait provides `static Key key(T const &)` returning an unsigned integer below the queue capacity. Custom
+ * traits let elements be indexed by an external or wider key, e.g. a dense 32-bit connection slot, without a
+ * wrapper type.
+ */
+struct GetIdKey
+{
+    template <typename T> static constexpr auto key(T const &c) -> decltype(c.GetId())
+    {
+        return c.GetId();
+    }
+};
+
+/**
+ * @brief Key type produced by the key trait `TKey` for elements of type `T`.
+ */
+template <typename TKey, typename T> using KeyType = decltype(TKey::key(std::declval<T const &>()));
+
+/**
+ * @brief Generation counter of an ID-indexed node table.
+ *
+ * A node only counts as occupied while its epoch equals the table's current epoch, so bumping the current epoch
+ * invalidates every node at once. Epoch 0 is never current, which makes zero-initialized nodes free.
+ */
+using Epoch = uint16_t;
+
+/**
+ * @enum NodeLayout
+ * @brief Memory layout of the ID-indexed node table of an intrusive queue.
+ *
+ * Values:
+ * - Interleaved: One array of `{prev, next, epoch, data}` nodes (array of structures).
+ * - Split: The `{prev, next}` links, the data pointers and the epochs live in separate arrays (structure of arrays),
+ *   so the list walked by `link()`/`unlink()` stays dense in cache.
+ */
+enum class NodeLayout
+{
+    Interleaved,
+    Split
+};
+
+/**
+ * @brief ID-indexed node table used by the intrusive queues.
+ *
+ * Provides `prev(id)`, `next(id)`, `data(id)` and `epoch(id)` accessors independent of the chosen layout.
+ *
+ * @tparam T        The element type the data pointers refer to.
+ * @tparam Capacity Number of nodes.
+ * @tparam Layout   Memory layout of the nodes.
+ */
+template <typename T, std::size_t Capacity, NodeLayout Layout> class NodeStorage;
+
+template <typename T, std::size_t Capacity> class NodeStorage<T, Capacity, NodeLayout::Interleaved>
+{
+  public:
+    using Index = LinkIndex<Capacity>;
+    static constexpr Index kNil{std::numeric_limits<Index>::max()};
+
+    constexpr Index &prev(std::size_t id)
+    {
+        return nodes_[id].prev;
+    }
+    constexpr Index prev(std::size_t id) const
+    {
+        return nodes_[id].prev;
+    }
+    constexpr Index &next(std::size_t id)
+    {
+        return nodes_[id].next;
+    }
+    constexpr Index next(std::size_t id) const
+    {
+        return nodes_[id].next;
+    }
+    constexpr T *&data(std::size_t id)
+    {
+        return nodes_[id].data;
+    }
+    constexpr T *data(std::size_t id) const
+    {
+        return nodes_[id].data;
+    }
+    constexpr Epoch &epoch(std::size_t id)
+    {
+        return nodes_[id].epoch;
+    }
+    constexpr Epoch epoch(std::size_t id) const
+    {
+        return nodes_[id].epoch;
+    }
+
+  private:
+    // With 8- and 16-bit links the epoch fills the padding before the data pointer; with 32-bit links it grows the
+    // node from 16 to 24 bytes
+    struct Node
+    {
+        Index prev{kNil};
+        Index next{kNil};
+        Epoch epoch{0};
+        T *data{nullptr};
+    };
+
+    std::array<Node, Capacity> nodes_{};
+};
+
+template <typename T, std::size_t Capacity> class NodeStorage<T, Capacity, NodeLayout::Split>
+{
+  public:
+    using Index = LinkIndex<Capacity>;
+    static constexpr Index kNil{std::numeric_limits<Index>::max()};
+
+    constexpr Index &prev(std::size_t id)
+    {
+        return links_[id].prev;
+    }
+    constexpr Index prev(std::size_t id) const
+    {
+        return links_[id].prev;
+    }
+    constexpr Index &next(std::size_t id)
+    {
+        return links_[id].next;
+    }
+    constexpr Index next(std::size_t id) const
+    {
+        return links_[id].next;
+    }
+    constexpr T *&data(std::size_t id)
+    {
+        return data_[id];
+    }
+    constexpr T *data(std::size_t id) const
+    {
+        return data_[id];
+    }
+    constexpr Epoch &epoch(std::size_t id)
+    {
+        return epochs_[id];
+    }
+    constexpr Epoch epoch(std::size_t id) const
+    {
+        return epochs_[id];
+    }
+
+  private:
+    struct Links
+    {
+        Index prev{kNil};
+        Index next{kNil};
+    };
+
+    std::array<Links, Capacity> links_{};
+    std::array<T *, Capacity> data_{};
+    // Kept out of the links so that they stay two indices wide
+    std::array<Epoch, Capacity> epochs_{};
+};
+
+} // namespace fcp
+
+#endif // INDEX_POLICY_HPP
@@ -0,0 +1,251 @@
+#ifndef INTRUSIVE_QUEUE_HPP
+#define INTRUSIVE_QUEUE_HPP
+
+#include "Queue.hpp"
+#include <cstddef>
+
+namespace fcp
+{
+
+/**
+ * @brief Links embedded in an element so that it can be threaded into an `IntrusiveQueue`.
+ *
+ * An element is in at most one queue per hook at a time; give it several hooks to be queued in several queues.
+ * Copying an element copies no links, so the copy's hook starts out unlinked. A hook must not be destroyed while its
+ * element is queued.
+ *
+ * @tparam T The element type that embeds the hook.
+ */
+template <typename T> class QueueHook
+{
+  public:
+    constexpr QueueHook() = default;
+    constexpr QueueHook(const QueueHook &)
+    {
+    }
+    constexpr QueueHook &operator=(const QueueHook &)
+    {
+        return *this;
+    }
+
+    /**
+     * @brief Returns true while the element is queued through this hook.
+     */
+    constexpr bool linked() const
+    {
+        return owner_ != nullptr;
+    }
+
+  private:
+    template <typename U, QueueHook<U> U::*> friend class IntrusiveQueue;
+
+    T *prev_{nullptr};
+    T *next_{nullptr};
+    Queue const *owner_{nullptr};
+};
+
+/**
+ * @brief An unbounded FIFO queue that threads elements through a hook embedded in each element.
+ *
+ * The IntrusiveQueue class is the intrusive counterpart of `UniqueIdQueue`:
+ * - No duplicate elements: The hook records the queue it is linked into, so pushing a queued element is rejected.
+ * - O(1) random removal: `remove()` unlinks the element through its own hook.
+ * - No per-capacity storage: The queue is three words; all links live inside the elements, so `link()`/`unlink()`
+ *   touch the element and its neighbours only, with no side table and no ID lookup.
+ *
+ * The queue does not own its elements. Queued elements must outlive their membership; the queue unlinks whatever
+ * is left when it is destroyed.
+ *
+ * @tparam T    The type of elements stored in the queue.
+ * @tparam Hook Pointer to the `QueueHook<T>` member of `T` used by this queue.
+ */
+template <typename T, QueueHook<T> T::*Hook> class IntrusiveQueue : public Queue
+{
+    using Status = Queue::Status;
+
+  public:
+    constexpr IntrusiveQueue() = default;
+
+    constexpr ~IntrusiveQueue()
+    {
+        clear();
+    }
+
+    // Queued elements point back at the queue, so it can be neither copied nor moved
+    IntrusiveQueue(const IntrusiveQueue &) = delete;
+    IntrusiveQueue &operator=(const IntrusiveQueue &) = delete;
+
+    IntrusiveQueue(IntrusiveQueue &&) = delete;
+    IntrusiveQueue &operator=(IntrusiveQueue &&) = delete;
+
+    /**
+     * @brief Appends an element to the back of the queue.
+     *
+     * @return Status::Ok, or Status::Duplicate if the element's hook is already linked, into this or any other queue.
+     */
+    constexpr Status push(T &c)
+    {
+        auto &h = hook(c);
+        if (h.linked())
+        {
+            return Status::Duplicate;
+        }
+
+        h.owner_ = this;
+        h.prev_ = tail_;
+        h.next_ = nullptr;
+        if (tail_ != nullptr)
+        {
+            hook(*tail_).next_ = &c;
+        }
+        else
+        {
+            head_ = &c;
+        }
+        tail_ = &c;
+        size_++;
+
+        return Status::Ok;
+    }
+
+    constexpr Status front(T *&out) const
+    {
+        if (empty())
+        {
+            return Status::Empty;
+        }
+
+        out = head_;
+
+        return Status::Ok;
+    }
+
+    constexpr Status pop(T *&out)
+    {
+        if (empty())
+        {
+            return Status::Empty;
+        }
+
+        out = head_;
+        unlink(*head_);
+
+        return Status::Ok;
+    }
+
+    /**
+     * @brief Unlinks the element from the queue.
+     *
+     * @return Status::Ok, Status::Empty, or Status::NotFound if the element is not queued in this queue.
+     */
+    constexpr Status remove(T &c)
+    {
+        if (empty())
+        {
+            return Status::Empty;
+        }
+
+        if (hook(c).owner_ != this)
+        {
+            return Status::NotFound;
+        }
+
+        unlink(c);
+
+        return Status::Ok;
+    }
+
+    /**
+     * @brief Returns true if the element is queued in this queue.
+     */
+    constexpr bool contains(T const &c) const
+    {
+        return hook(c).owner_ == this;
+    }
+
+    /**
+     * @brief Calls `visitor(T &)` for every queued element in FIFO order without modifying the queue.
+     */
+    template <typename Visitor> constexpr void for_each(Visitor &&visitor) const
+    {
+        for (auto *c = head_; c != nullptr; c = hook(*c).next_)
+        {
+            visitor(*c);
+        }
+    }
+
+    /**
+     * @brief Unlinks all elements.
+     *
+     * Walks the list once, as every hook has to be reset before its element can be queued again.
+     */
+    constexpr void clear()
+    {
+        auto *c = head_;
+        while (c != nullptr)
+        {
+            auto &h = hook(*c);
+            c = h.next_;
+            h.prev_ = nullptr;
+            h.next_ = nullptr;
+            h.owner_ = nullptr;
+        }
+        head_ = nullptr;
+        tail_ = nullptr;
+        size_ = 0;
+    }
+
+    constexpr std::size_t size() const
+    {
+        return size_;
+    }
+
+    constexpr bool empty() const
+    {
+        return size_ == 0;
+    }
+
+  private:
+    static constexpr QueueHook<T> &hook(T &c)
+    {
+        return c.*Hook;
+    }
+
+    static constexpr QueueHook<T> const &hook(T const &c)
+    {
+        return c.*Hook;
+    }
+
+    constexpr void unlink(T &c)
+    {
+        auto &h = hook(c);
+        if (h.prev_ != nullptr)
+        {
+            hook(*h.prev_).next_ = h.next_;
+        }
+        else
+        {
+            head_ = h.next_;
+        }
+        if (h.next_ != nullptr)
+        {
+            hook(*h.next_).prev_ = h.prev_;
+        }
+        else
+        {
+            tail_ = h.prev_;
+        }
+        h.prev_ = nullptr;
+        h.next_ = nullptr;
+        h.owner_ = nullptr;
+        size_--;
+    }
+
+    T *head_{nullptr};
+    T *tail_{nullptr};
+    std::size_t size_{0};
+};
+
+} // namespace fcp
+
+#endif // INTRUSIVE_QUEUE_HPP
@@ -0,0 +1,233 @@
+#ifndef MPMC_QUEUE_HPP
+#define MPMC_QUEUE_HPP
+
+#include "Platform.hpp"
+#include "Queue.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace fcp
+{
+
+/**
+ * @brief Semaphore placeholder for an MpmcQueue without blocking waits.
+ */
+struct NoWaitSemaphore
+{
+};
+
+/**
+ * @brief Semaphore trait that never blocks: `wait` only evaluates the predicate once.
+ */
+struct NoWaitSemaphoreTrait
+{
+    static void init(NoWaitSemaphore &)
+    {
+    }
+
+    template <typename Predicate> static bool wait(NoWaitSemaphore &, Predicate pred, long)
+    {
+        return pred();
+    }
+
+    static void notify(NoWaitSemaphore &)
+    {
+    }
+};
+
+/**
+ * @brief A fixed-capacity, lock-free multi-producer/multi-consumer queue.
+ *
+ * The MpmcQueue class implements Dmitry Vyukov's bounded MPMC queue:
+ * - Every slot carries a sequence number that tells producers and consumers whether the slot is free or holds a
+ *   published element for their ticket, so `push` and `pop` only contend on a single CAS of their own cursor.
+ * - The enqueue and dequeue cursors live on separate cache lines.
+ * - No dynamic memory allocation: All storage is preallocated based on the specified capacity.
+ * - Optional blocking `pop` with timeout through a user-supplied semaphore type/trait.
+ *
+ * Unlike the trait used by TimeoutQueue, the semaphore trait here has no queue mutex to work with:
+ * - `init(TSemaphore &)`
+ * - `bool wait(TSemaphore &, Predicate pred, long timeout_us)` blocks until `pred()` returns true or the timeout
+ *   expires (`timeout_us < 0` waits forever, `0` evaluates `pred` once) and returns the last result of `pred()`.
+ * - `notify(TSemaphore &)` wakes one waiter. It must synchronize with `wait` (e.g. by taking the mutex the waiter
+ *   evaluates `pred` under) so that a notify between a failed `pred()` and going to sleep is not lost.
+ *
+ * @tparam T               The type of elements stored in the queue. Must be default-constructible and movable.
+ * @tparam Capacity        Maximum number of elements in the queue. Must be a power of two.
+ * @tparam TSemaphore      Semaphore type for blocking operations.
+ * @tparam TSemaphoreTrait Trait class providing static wait/notify/init for TSemaphore.
+ */
+template <typename T, std::size_t Capacity, typename TSemaphore = NoWaitSemaphore,
+          typename TSemaphoreTrait = NoWaitSemaphoreTrait>
+class MpmcQueue : public Queue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "MpmcQueue requires a Capacity that is a power of two and at least 2");
+
+    using Status = Queue::Status;
+
+  public:
+    MpmcQueue()
+    {
+        for (std::size_t i = 0; i < Capacity; ++i)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        TSemaphoreTrait::init(semaphore_);
+    }
+
+    MpmcQueue(const MpmcQueue &) = delete;
+    MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+    MpmcQueue(MpmcQueue &&) = delete;
+    MpmcQueue &operator=(MpmcQueue &&) = delete;
+
+    /**
+     * @brief Appends an element. Safe to call from any number of threads.
+     *
+     * @param element The element to copy into the queue.
+     * @return Status::Ok on success, Status::Full if the queue is full.
+     */
+    Status push(T const &element)
+    {
+        auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+        for (;;)
+        {
+            cell = &cells_[pos & kMask];
+            auto const seq = cell->sequence.load(std::memory_order_acquire);
+            auto const diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return Status::Full;
+            }
+            else
+            {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = element;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        // Pairs with the fence in pop(): either the waiter sees the element or we see the waiter.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) > 0)
+        {
+            TSemaphoreTrait::notify(semaphore_);
+        }
+
+        return Status::Ok;
+    }
+
+    /**
+     * @brief Removes the oldest element. Safe to call from any number of threads.
+     *
+     * @param[out] out Receives the removed element.
+     * @param timeout_us Time to wait for an element: 0 returns immediately, a negative value waits forever.
+     * @return Status::Ok on success, Status::Empty if no element became available.
+     */
+    Status pop(T &out, long timeout_us = 0)
+    {
+        if (try_pop(out))
+        {
+            return Status::Ok;
+        }
+        if (timeout_us == 0)
+        {
+            return Status::Empty;
+        }
+
+        waiters_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto pred = [this, &out] { return try_pop(out); };
+        bool const ok = TSemaphoreTrait::wait(semaphore_, pred, timeout_us);
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+
+        return ok ? Status::Ok : Status::Empty;
+    }
+
+    /**
+     * @brief Returns the number of queued elements.
+     *
+     * @note When called concurrently with `push`/`pop` the result is a snapshot that may already be stale.
+     */
+    std::size_t size() const
+    {
+        auto const head = dequeue_pos_.load(std::memory_order_acquire);
+        auto const tail = enqueue_pos_.load(std::memory_order_acquire);
+        return tail > head ? std::min<std::size_t>(tail - head, Capacity) : 0;
+    }
+
+    bool full() const
+    {
+        return size() == Capacity;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+  private:
+    static constexpr std::size_t kMask{Capacity - 1};
+
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence{0};
+        T data{};
+    };
+
+    bool try_pop(T &out)
+    {
+        auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+        for (;;)
+        {
+            cell = &cells_[pos & kMask];
+            auto const seq = cell->sequence.load(std::memory_order_acquire);
+            auto const diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        out = std::move(cell->data);
+        cell->sequence.store(pos + kMask + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(kCacheLineSize) std::atomic<std::size_t> dequeue_pos_{0};
+    alignas(kCacheLineSize) std::atomic<std::size_t> waiters_{0};
+    TSemaphore semaphore_;
+    alignas(kCacheLineSize) std::array<Cell, Capacity> cells_{};
+};
+
+} // namespace fcp
+
+#endif // MPMC_QUEUE_HPP
@@ -0,0 +1,218 @@
+#ifndef OBJECT_POOL_HPP
+#define OBJECT_POOL_HPP
+
+#include "IndexPolicy.hpp"
+#include "Queue.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace fcp
+{
+
+/**
+ * @brief A fixed-capacity object pool whose slot indices are the IDs used by the ID-indexed queues.
+ *
+ * ObjectPool owns the storage of the elements that TimeoutQueue, UniqueIdQueue and friends link by pointer:
+ * - Dense IDs for free: `acquire()` constructs the object as `T(id, args...)` in slot `id`, so the ID handed to the
+ *   object is unique for as long as it is alive and lies in the same range `0 .. Capacity - 1` the queues index by.
+ * - O(1) acquire and release: Free slots form an intrusive LIFO free list whose links live in the unused slots
+ *   themselves, so a recently released, still cached slot is handed out first.
+ * - Contiguous storage: Objects are laid out in ID order, so walking a queue whose IDs are close together walks
+ *   neighbouring memory.
+ * - No dynamic memory allocation: All storage is preallocated based on the specified capacity.
+ *
+ * The pool is not thread-safe; guard it with the same lock as the code that acquires and releases the objects.
+ *
+ * @tparam T        The type of pooled objects. Must be constructible from its ID followed by the `acquire()`
+ *                  arguments.
+ * @tparam Capacity Number of slots, i.e. the ID range `0 .. Capacity - 1`.
+ * @tparam TKey     Key trait providing `static Key key(T const &)`, used by `release()` to find the slot of an
+ *                  object; see `GetIdKey`.
+ */
+template <typename T, std::size_t Capacity, typename TKey = GetIdKey> class ObjectPool : public Queue
+{
+    static_assert(Capacity > 0, "ObjectPool requires a Capacity greater than zero");
+
+    using Status = Queue::Status;
+    using Index = LinkIndex<Capacity>;
+    static constexpr Index kNil{std::numeric_limits<Index>::max()};
+
+  public:
+    /// Type of the ID passed to the constructor of the pooled objects.
+    using Id = std::conditional_t<(Capacity <= Queue::kMaxCapacity), uint16_t, uint32_t>;
+
+    constexpr ObjectPool()
+    {
+        for (std::size_t i = 0; i < Capacity; ++i)
+        {
+            std::construct_at(&slots_[i].next_free, i + 1 < Capacity ? static_cast<Index>(i + 1) : kNil);
+        }
+    }
+
+    constexpr ~ObjectPool()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            for (std::size_t i = 0; i < Capacity; ++i)
+            {
+                if (live_[i])
+                {
+                    std::destroy_at(&slots_[i].value);
+                }
+            }
+        }
+    }
+
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    ObjectPool(ObjectPool &&) = delete;
+    ObjectPool &operator=(ObjectPool &&) = delete;
+
+    /**
+     * @brief Takes a free slot and constructs `T(id, args...)` in it.
+     *
+     * If the constructor throws, the exception propagates and the slot stays free.
+     *
+     * @param[out] out Set to the new object.
+     * @return Status::Ok on success, Status::Full if every slot is in use.
+     */
+    template <typename... Args> constexpr Status acquire(T *&out, Args &&...args)
+    {
+        if (free_ == kNil)
+        {
+            return Status::Full;
+        }
+
+        auto const id = static_cast<std::size_t>(free_);
+        auto &slot = slots_[id];
+        // The slot only leaves the free list once the object exists. A throwing constructor may already have
+        // overwritten the link, so it is restored before the exception propagates.
+        auto const next = slot.next_free;
+#if defined(__cpp_exceptions)
+        try
+        {
+            std::construct_at(&slot.value, static_cast<Id>(id), std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            std::construct_at(&slot.next_free, next);
+            throw;
+        }
+#else
+        std::construct_at(&slot.value, static_cast<Id>(id), std::forward<Args>(args)...);
+#endif
+        free_ = next;
+        live_[id] = true;
+        size_++;
+
+        out = &slot.value;
+        return Status::Ok;
+    }
+
+    /**
+     * @brief Destroys an object obtained from `acquire()` and returns its slot, and thereby its ID, to the pool.
+     *
+     * The object must no longer be linked into any queue, and must not be used, or released again, afterwards.
+     *
+     * @return Status::Ok on success, Status::InvalidId if the object's ID is out of range, Status::NotFound if it is
+     *         not the live object of this pool with that ID.
+     */
+    constexpr Status release(T &obj)
+    {
+        auto const id = static_cast<std::size_t>(TKey::key(obj));
+        if (id >= Capacity)
+        {
+            return Status::InvalidId;
+        }
+        auto &slot = slots_[id];
+        if (!live_[id] || &slot.value != &obj)
+        {
+            return Status::NotFound;
+        }
+
+        std::destroy_at(&slot.value);
+        live_[id] = false;
+        std::construct_at(&slot.next_free, free_);
+        free_ = static_cast<Index>(id);
+        size_--;
+
+        return Status::Ok;
+    }
+
+    /**
+     * @brief Returns the live object with the given ID, or nullptr if the slot is free or the ID is out of range.
+     */
+    constexpr T *get(std::size_t id)
+    {
+        return id < Capacity && live_[id] ? &slots_[id].value : nullptr;
+    }
+
+    constexpr T const *get(std::size_t id) const
+    {
+        return id < Capacity && live_[id] ? &slots_[id].value : nullptr;
+    }
+
+    /**
+     * @brief Returns the number of live objects.
+     */
+    constexpr std::size_t size() const
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Returns the number of free slots.
+     */
+    constexpr std::size_t available() const
+    {
+        return Capacity - size_;
+    }
+
+    static constexpr std::size_t capacity()
+    {
+        return Capacity;
+    }
+
+    constexpr bool full() const
+    {
+        return size_ == Capacity;
+    }
+
+    constexpr bool empty() const
+    {
+        return size_ == 0;
+    }
+
+  private:
+    // A free slot holds the link to the next free slot, a live one the object
+    union Slot
+    {
+        constexpr Slot()
+        {
+        }
+        constexpr ~Slot()
+            requires std::is_trivially_destructible_v<T>
+        = default;
+        constexpr ~Slot()
+        {
+        }
+
+        Index next_free;
+        T value;
+    };
+
+    std::array<Slot, Capacity> slots_;
+    std::array<bool, Capacity> live_{};
+    Index free_{0};
+    std::size_t size_{0};
+};
+
+} // namespace fcp
+
+#endif // OBJECT_POOL_HPP
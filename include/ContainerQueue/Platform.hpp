@@ -0,0 +1,43 @@
+#ifndef PLATFORM_HPP
+#define PLATFORM_HPP
+
+#include <cstddef>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+/**
+ * @def FCP_CACHE_LINE_SIZE
+ * @brief Size in bytes used to keep independently written fields on separate cache lines.
+ *
+ * A fixed constant is used instead of `std::hardware_destructive_interference_size`, whose value may change with
+ * compiler version or tuning flags and would silently change the layout (and ABI) of the queues. Override it on the
+ * command line for targets with a different line size.
+ */
+#ifndef FCP_CACHE_LINE_SIZE
+#define FCP_CACHE_LINE_SIZE 64
+#endif
+
+namespace fcp
+{
+
+inline constexpr std::size_t kCacheLineSize{FCP_CACHE_LINE_SIZE};
+
+/**
+ * @brief Hints the CPU that the caller is in a spin-wait loop.
+ */
+inline void cpu_relax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#endif
+}
+
+} // namespace fcp
+
+#endif // PLATFORM_HPP
@@ -1,12 +1,24 @@
 #ifndef QUEUE_HPP
 #define QUEUE_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
 namespace fcp
 {
 
 class Queue
 {
   public:
+    /**
+     * @brief Largest capacity addressable by `uint16_t` IDs.
+     *
+     * The value `std::numeric_limits<uint16_t>::max()` is reserved as the "no node" link, so the valid IDs are
+     * `0 .. kMaxCapacity - 1`.
+     */
+    static constexpr std::size_t kMaxCapacity{std::numeric_limits<uint16_t>::max()};
+
     /**
      * @enum Status
      * @brief Represents the status codes returned by TimeoutQueue operations.
@@ -22,6 +34,7 @@ class Queue
      * - Duplicate: An attempt was made to insert a duplicate element.
      * - NotFound: The requested element was not found in the queue.
      * - InvalidId: An invalid identifier was provided.
+     * - Timeout: A blocking operation gave up before it could complete.
      */
     enum class Status
     {
@@ -53,6 +66,8 @@ class Queue
             return "NotFound";
         case Status::InvalidId:
             return "InvalidId";
+        case Status::Timeout:
+            return "Timeout";
         default:
             return "Unknown";
         }
@@ -0,0 +1,215 @@
+#ifndef QUEUE_SET_HPP
+#define QUEUE_SET_HPP
+
+#include "Platform.hpp"
+#include "Queue.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace fcp
+{
+
+/**
+ * @enum SelectPolicy
+ * @brief Order in which `QueueSet::pop_any()` visits its member queues.
+ *
+ * Values:
+ * - Priority: Always starts with the first queue, so a queue is only served while all queues before it are empty.
+ * - RoundRobin: Starts after the queue that was served last, so a busy queue cannot starve the others.
+ */
+enum class SelectPolicy
+{
+    Priority,
+    RoundRobin
+};
+
+/**
+ * @brief Waits on several TimeoutQueues at once and pops from whichever has an element.
+ *
+ * QueueSet replaces polling loops over `pop(out, 0)` and thread-per-queue consumers:
+ * - One wakeup primitive: The set has its own mutex and semaphore, of the member queues' types, and registers itself
+ *   as push listener of every member. A push only touches them when a consumer is actually blocked in the set.
+ * - Selection: `pop_any()` visits the members in the order given by `Policy`; see `SelectPolicy`.
+ * - The member queues stay ordinary queues: producers push to them directly, and their own `pop()` and
+ *   `async_pop()` keep working alongside the set.
+ *
+ * A queue can belong to one set at a time. The set must outlive the pushes that may still notify it, and the
+ * queues must outlive the set.
+ *
+ * @tparam TQueue The member queue type, a `TimeoutQueue` instantiation.
+ * @tparam N      Number of member queues.
+ * @tparam Policy Order in which the members are visited.
+ */
+template <typename TQueue, std::size_t N, SelectPolicy Policy = SelectPolicy::Priority> class QueueSet : public Queue
+{
+    static_assert(N > 0, "QueueSet requires at least one queue");
+
+    using Status = Queue::Status;
+    using T = typename TQueue::value_type;
+    using TMutex = typename TQueue::Mutex;
+    using TSemaphore = typename TQueue::Semaphore;
+    using TMutexTrait = typename TQueue::MutexTrait;
+    using TSemaphoreTrait = typename TQueue::SemaphoreTrait;
+
+  public:
+    /**
+     * @brief Builds a set over the given queues, in priority order, and registers it with each of them.
+     */
+    template <typename... Queues>
+        requires(sizeof...(Queues) == N)
+    explicit QueueSet(Queues &...queues) : queues_{&queues...}
+    {
+        TMutexTrait::init(mutex_);
+        TSemaphoreTrait::init(semaphore_);
+        for (auto *queue : queues_)
+        {
+            queue->set_push_listener(&listener_);
+        }
+    }
+
+    ~QueueSet()
+    {
+        for (auto *queue : queues_)
+        {
+            queue->set_push_listener(nullptr);
+        }
+    }
+
+    QueueSet(const QueueSet &) = delete;
+    QueueSet &operator=(const QueueSet &) = delete;
+
+    QueueSet(QueueSet &&) = delete;
+    QueueSet &operator=(QueueSet &&) = delete;
+
+    /**
+     * @brief Removes and retrieves the front element of the first non-empty member queue.
+     *
+     * @param[out] out Reference to a pointer that will be set to the popped element.
+     * @param timeout_us Time to wait for an element: 0 returns immediately, a negative value waits forever.
+     * @return Status::Ok, or Status::Empty if every queue stayed empty.
+     */
+    Status pop_any(T *&out, long timeout_us = 0)
+    {
+        std::size_t from = 0;
+        return pop_any_from(out, from, timeout_us);
+    }
+
+    /**
+     * @brief Same as `pop_any()`, and also reports which member queue the element came from.
+     *
+     * @param[out] out Reference to a pointer that will be set to the popped element.
+     * @param[out] from Set to the index of the queue the element was popped from.
+     * @param timeout_us Time to wait for an element: 0 returns immediately, a negative value waits forever.
+     * @return Status::Ok, or Status::Empty if every queue stayed empty.
+     */
+    Status pop_any_from(T *&out, std::size_t &from, long timeout_us = 0)
+    {
+        if (try_pop(out, from))
+        {
+            return Status::Ok;
+        }
+        if (timeout_us == 0)
+        {
+            return Status::Empty;
+        }
+
+        TMutexTrait::lock(mutex_);
+        waiters_.fetch_add(1, std::memory_order_relaxed);
+        // Pairs with the fence in on_push() before the sweep reads the queue sizes
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto const sweep = [this, &out, &from] {
+            sweeping_ = this;
+            auto const found = try_pop(out, from);
+            sweeping_ = nullptr;
+            return found;
+        };
+        auto const ok = TSemaphoreTrait::wait(semaphore_, mutex_, sweep, timeout_us);
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        TMutexTrait::unlock(mutex_);
+
+        return ok ? Status::Ok : Status::Empty;
+    }
+
+    /**
+     * @brief Returns the member queue at `index`.
+     */
+    TQueue &queue(std::size_t index) const
+    {
+        return *queues_[index];
+    }
+
+    /**
+     * @brief Lock-free, possibly stale check whether every member queue is empty.
+     */
+    bool empty() const
+    {
+        return std::all_of(queues_.begin(), queues_.end(), [](TQueue const *queue) { return queue->empty(); });
+    }
+
+  private:
+    // One sweep over the members in policy order; skips queues whose lock-free size says they are empty
+    bool try_pop(T *&out, std::size_t &from)
+    {
+        std::size_t start = 0;
+        if constexpr (Policy == SelectPolicy::RoundRobin)
+        {
+            start = next_.load(std::memory_order_relaxed);
+        }
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            auto const i = (start + k) % N;
+            if (!queues_[i]->empty() && queues_[i]->pop(out) == Status::Ok)
+            {
+                from = i;
+                if constexpr (Policy == SelectPolicy::RoundRobin)
+                {
+                    next_.store((i + 1) % N, std::memory_order_relaxed);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void on_push(void *context, std::size_t added)
+    {
+        auto &set = *static_cast<QueueSet *>(context);
+        // Pairs with the waiter registration in pop_any(): either the consumer sees this element in its sweep, or this
+        // sees the consumer
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto const waiting = set.waiters_.load(std::memory_order_relaxed);
+        if (waiting == 0)
+        {
+            return;
+        }
+        // A registered consumer holds mutex_ until it blocks, so the signal cannot fall in between. A pop in the
+        // sweep may itself add elements (by admitting a suspended async_push); that thread already holds mutex_.
+        if (sweeping_ != &set)
+        {
+            TMutexTrait::lock(set.mutex_);
+            TMutexTrait::unlock(set.mutex_);
+        }
+        for (std::size_t i = 0, n = std::min(added, waiting); i < n; ++i)
+        {
+            TSemaphoreTrait::notify(set.semaphore_);
+        }
+    }
+
+    // The set whose mutex the calling thread holds while it sweeps the members, if any
+    static inline thread_local QueueSet const *sweeping_{nullptr};
+
+    std::array<TQueue *, N> queues_;
+    typename TQueue::PushListener const listener_{&QueueSet::on_push, this};
+    // Queue the next round-robin sweep starts at
+    std::atomic<std::size_t> next_{0};
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> waiters_{0};
+    TMutex mutex_;
+    TSemaphore semaphore_;
+};
+
+} // namespace fcp
+
+#endif // QUEUE_SET_HPP
@@ -0,0 +1,232 @@
+#ifndef QUEUE_STATS_HPP
+#define QUEUE_STATS_HPP
+
+#include "Queue.hpp"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace fcp
+{
+
+/**
+ * @brief Point-in-time copy of the counters of a `QueueStats` policy.
+ *
+ * Histogram bucket `i` counts durations `d` in nanoseconds with `std::bit_width(d) == i`, i.e. bucket 0 holds `d == 0`
+ * and bucket `i > 0` holds `2^(i-1) <= d < 2^i`; the last bucket also holds everything longer. The histograms stay
+ * zero unless the policy is `QueueStats<true>`.
+ */
+struct QueueStatsSnapshot
+{
+    static constexpr std::size_t kBuckets{32};
+
+    uint64_t pushes{0};
+    uint64_t pops{0};
+    uint64_t removes{0};
+    uint64_t full{0};
+    uint64_t duplicate{0};
+    uint64_t empty{0};
+    uint64_t high_water{0};
+    std::array<uint64_t, kBuckets> lock_hold_ns{};
+    std::array<uint64_t, kBuckets> wait_ns{};
+};
+
+/**
+ * @brief Statistics policy that records nothing.
+ *
+ * The default of every queue. All hooks are empty and the member is `[[no_unique_address]]`, so a queue without
+ * statistics has the same size and code as before the hooks existed.
+ *
+ * A statistics policy provides:
+ * - `on_push(n, size)`: `n` elements were pushed, the queue now holds `size`.
+ * - `on_pop(n)`, `on_remove(n)`: `n` elements left the queue through pop or remove (including drain/clear/expiry).
+ * - `on_reject(status)`: an operation failed with Status::Full, Status::Duplicate or Status::Empty.
+ * - `on_lock_hold(ns)`, `on_wait(ns)`: only called when `kTimed` is true, by queues that lock or block.
+ */
+struct NoStats
+{
+    static constexpr bool kTimed{false};
+
+    constexpr void on_push(std::size_t, std::size_t)
+    {
+    }
+    constexpr void on_pop(std::size_t)
+    {
+    }
+    constexpr void on_remove(std::size_t)
+    {
+    }
+    constexpr void on_reject(Queue::Status)
+    {
+    }
+    constexpr void on_lock_hold(uint64_t)
+    {
+    }
+    constexpr void on_wait(uint64_t)
+    {
+    }
+};
+
+/**
+ * @brief Statistics policy with relaxed atomic counters and, optionally, log2 latency histograms.
+ *
+ * Updates are single relaxed read-modify-writes, so the hooks never block and `snapshot()` can be called from any
+ * thread at any time. Counters are read one by one; a snapshot taken while the queue is in use is not an atomic cut
+ * across all counters.
+ *
+ * @note Hook calls run inside the queue operations. With `Timed`, TimeoutQueue additionally reads the steady clock
+ * around every lock hold and blocking wait, which costs far more than the counters; leave it off to only count.
+ *
+ * @tparam Timed Whether to record the lock hold and wait time histograms.
+ */
+template <bool Timed = false> class QueueStats
+{
+  public:
+    static constexpr bool kTimed{Timed};
+    static constexpr std::size_t kBuckets{QueueStatsSnapshot::kBuckets};
+
+    QueueStats() = default;
+
+    // Copying a queue copies its counters, so the copy starts from the same history
+    QueueStats(const QueueStats &other)
+    {
+        restore(other.snapshot());
+    }
+    QueueStats &operator=(const QueueStats &other)
+    {
+        if (this != &other)
+        {
+            restore(other.snapshot());
+        }
+        return *this;
+    }
+
+    void on_push(std::size_t n, std::size_t size)
+    {
+        add(pushes_, n);
+        auto seen = high_water_.load(std::memory_order_relaxed);
+        while (size > seen && !high_water_.compare_exchange_weak(seen, size, std::memory_order_relaxed))
+        {
+        }
+    }
+    void on_pop(std::size_t n)
+    {
+        add(pops_, n);
+    }
+    void on_remove(std::size_t n)
+    {
+        add(removes_, n);
+    }
+    void on_reject(Queue::Status status)
+    {
+        switch (status)
+        {
+        case Queue::Status::Full:
+            add(full_, 1);
+            break;
+        case Queue::Status::Duplicate:
+            add(duplicate_, 1);
+            break;
+        case Queue::Status::Empty:
+            add(empty_, 1);
+            break;
+        default:
+            break;
+        }
+    }
+    void on_lock_hold(uint64_t ns)
+    {
+        if constexpr (Timed)
+        {
+            add(lock_hold_ns_[bucket(ns)], 1);
+        }
+    }
+    void on_wait(uint64_t ns)
+    {
+        if constexpr (Timed)
+        {
+            add(wait_ns_[bucket(ns)], 1);
+        }
+    }
+
+    /**
+     * @brief Reads all counters without synchronizing with the queue.
+     */
+    QueueStatsSnapshot snapshot() const
+    {
+        QueueStatsSnapshot s;
+        s.pushes = load(pushes_);
+        s.pops = load(pops_);
+        s.removes = load(removes_);
+        s.full = load(full_);
+        s.duplicate = load(duplicate_);
+        s.empty = load(empty_);
+        s.high_water = load(high_water_);
+        if constexpr (Timed)
+        {
+            for (std::size_t i = 0; i < kBuckets; ++i)
+            {
+                s.lock_hold_ns[i] = load(lock_hold_ns_[i]);
+                s.wait_ns[i] = load(wait_ns_[i]);
+            }
+        }
+        return s;
+    }
+
+    /**
+     * @brief Histogram bucket of a duration in nanoseconds, see `QueueStatsSnapshot`.
+     */
+    static constexpr std::size_t bucket(uint64_t ns)
+    {
+        auto const width = static_cast<std::size_t>(std::bit_width(ns));
+        return width < kBuckets ? width : kBuckets - 1;
+    }
+
+  private:
+    using Counter = std::atomic<uint64_t>;
+
+    static void add(Counter &c, uint64_t n)
+    {
+        c.fetch_add(n, std::memory_order_relaxed);
+    }
+    static uint64_t load(Counter const &c)
+    {
+        return c.load(std::memory_order_relaxed);
+    }
+
+    void restore(QueueStatsSnapshot const &s)
+    {
+        pushes_.store(s.pushes, std::memory_order_relaxed);
+        pops_.store(s.pops, std::memory_order_relaxed);
+        removes_.store(s.removes, std::memory_order_relaxed);
+        full_.store(s.full, std::memory_order_relaxed);
+        duplicate_.store(s.duplicate, std::memory_order_relaxed);
+        empty_.store(s.empty, std::memory_order_relaxed);
+        high_water_.store(s.high_water, std::memory_order_relaxed);
+        if constexpr (Timed)
+        {
+            for (std::size_t i = 0; i < kBuckets; ++i)
+            {
+                lock_hold_ns_[i].store(s.lock_hold_ns[i], std::memory_order_relaxed);
+                wait_ns_[i].store(s.wait_ns[i], std::memory_order_relaxed);
+            }
+        }
+    }
+
+    Counter pushes_{0};
+    Counter pops_{0};
+    Counter removes_{0};
+    Counter full_{0};
+    Counter duplicate_{0};
+    Counter empty_{0};
+    Counter high_water_{0};
+    // Empty unless timed, so a counting-only policy stays small
+    std::array<Counter, Timed ? kBuckets : 0> lock_hold_ns_{};
+    std::array<Counter, Timed ? kBuckets : 0> wait_ns_{};
+};
+
+} // namespace fcp
+
+#endif // QUEUE_STATS_HPP
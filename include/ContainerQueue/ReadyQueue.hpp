@@ -0,0 +1,298 @@
+#ifndef READY_QUEUE_HPP
+#define READY_QUEUE_HPP
+
+#include "IndexPolicy.hpp"
+#include "Queue.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace fcp
+{
+
+/**
+ * @brief A fixed-capacity scheduler ready list with priority levels, O(1) random removal and no duplicate elements.
+ *
+ * The ReadyQueue class keeps one FIFO list per priority level, all threaded through a single ID-indexed node table:
+ * - No duplicate elements: Each element is uniquely identified by its `GetId()` method, and only one instance of each
+ * ID can be ready at a time, regardless of its priority.
+ * - O(1) dispatch: A bitmap of non-empty levels locates the highest ready priority with a single count-leading-zeros
+ * instead of scanning the levels.
+ * - O(1) random removal and reprioritization by ID.
+ * - No dynamic memory allocation: All storage is preallocated based on the specified capacity.
+ *
+ * Higher level numbers are more urgent: `pop()` returns the oldest element of the highest non-empty level.
+ *
+ * @tparam T        The type of elements stored in the queue. Must provide `uint16_t GetId() const`.
+ * @tparam Capacity Number of node slots, i.e. the ID range `0 .. Capacity - 1`.
+ * @tparam Levels   Number of priority levels, at most 64.
+ */
+template <typename T, std::size_t Capacity, std::size_t Levels> class ReadyQueue : public Queue
+{
+    static_assert(std::is_same<decltype(std::declval<const T &>().GetId()), uint16_t>::value,
+                  "ReadyQueue requires T to have a method `uint16_t GetId() const`");
+    static_assert(Capacity > 0 && Capacity <= Queue::kMaxCapacity,
+                  "ReadyQueue Capacity must be in the range [1, Queue::kMaxCapacity]");
+    static_assert(Levels > 0 && Levels <= 64, "ReadyQueue supports between 1 and 64 priority levels");
+
+    using Status = Queue::Status;
+
+  public:
+    /**
+     * @brief Constructs a ReadyQueue that accepts IDs below `capacity` (clamped to `Capacity`).
+     */
+    explicit constexpr ReadyQueue(uint16_t capacity = Capacity)
+        : capacity_{static_cast<uint16_t>(std::min<std::size_t>(capacity, Capacity))}
+    {
+    }
+
+    /**
+     * @brief Appends an element to the back of the given priority level.
+     *
+     * @return Status::Ok, Status::Full, Status::InvalidId (ID or priority out of range) or Status::Duplicate.
+     */
+    constexpr Status push(T &c, std::size_t priority)
+    {
+        if (full())
+        {
+            return Status::Full;
+        }
+
+        auto const id = c.GetId();
+
+        if (!IdValid(id) || priority >= Levels)
+        {
+            return Status::InvalidId;
+        }
+
+        auto &node = data_[id];
+
+        if (node.data != nullptr)
+        {
+            return Status::Duplicate;
+        }
+
+        node.data = &c;
+        link(id, priority);
+        size_++;
+
+        return Status::Ok;
+    }
+
+    /**
+     * @brief Retrieves, but does not remove, the oldest element of the highest ready priority.
+     */
+    constexpr Status front(T *&out) const
+    {
+        if (empty())
+        {
+            return Status::Empty;
+        }
+
+        out = data_[head_[top()]].data;
+
+        return Status::Ok;
+    }
+
+    /**
+     * @brief Removes and retrieves the oldest element of the highest ready priority.
+     */
+    constexpr Status pop(T *&out)
+    {
+        if (empty())
+        {
+            return Status::Empty;
+        }
+
+        auto const id = head_[top()];
+        out = data_[id].data;
+        unlink(id);
+        size_--;
+
+        return Status::Ok;
+    }
+
+    constexpr Status remove(T &c)
+    {
+        if (empty())
+        {
+            return Status::Empty;
+        }
+
+        return remove(c.GetId());
+    }
+
+    constexpr Status remove(uint16_t id)
+    {
+        if (!IdValid(id))
+        {
+            return Status::InvalidId;
+        }
+
+        if (data_[id].data == nullptr)
+        {
+            return Status::NotFound;
+        }
+
+        unlink(id);
+        size_--;
+
+        return Status::Ok;
+    }
+
+    /**
+     * @brief Moves a ready element to the back of another priority level.
+     *
+     * Keeps its position if the priority does not change.
+     *
+     * @return Status::Ok, Status::InvalidId (ID or priority out of range) or Status::NotFound.
+     */
+    constexpr Status reprioritize(uint16_t id, std::size_t priority)
+    {
+        if (!IdValid(id) || priority >= Levels)
+        {
+            return Status::InvalidId;
+        }
+
+        auto &node = data_[id];
+
+        if (node.data == nullptr)
+        {
+            return Status::NotFound;
+        }
+
+        if (node.level != priority)
+        {
+            auto *const c = node.data;
+            unlink(id);
+            node.data = c;
+            link(id, priority);
+        }
+
+        return Status::Ok;
+    }
+
+    /**
+     * @brief Retrieves the highest priority level that has a ready element.
+     */
+    constexpr Status top_priority(std::size_t &out) const
+    {
+        if (empty())
+        {
+            return Status::Empty;
+        }
+
+        out = top();
+
+        return Status::Ok;
+    }
+
+    constexpr std::size_t size() const
+    {
+        return size_;
+    }
+
+    constexpr bool full() const
+    {
+        return size_ == capacity_;
+    }
+
+    constexpr bool empty() const
+    {
+        return size_ == 0;
+    }
+
+  private:
+    using Index = LinkIndex<Capacity>;
+    static constexpr Index kNil{std::numeric_limits<Index>::max()};
+    static_assert(Capacity - 1 < kNil, "ReadyQueue IDs must stay below the nil link of the chosen index type");
+
+    struct Node
+    {
+        Index prev{kNil};
+        Index next{kNil};
+        uint8_t level{0};
+        T *data{nullptr};
+    };
+
+    constexpr bool IdValid(uint16_t id) const
+    {
+        return id < capacity_;
+    }
+
+    constexpr std::size_t top() const
+    {
+        return 63 - std::countl_zero(ready_);
+    }
+
+    static constexpr std::array<Index, Levels> make_nil_array()
+    {
+        std::array<Index, Levels> a{};
+        a.fill(kNil);
+        return a;
+    }
+
+    constexpr void link(std::size_t id, std::size_t level)
+    {
+        auto const idx = static_cast<Index>(id);
+        auto &n = data_[id];
+        auto &tail = tail_[level];
+        n.prev = tail;
+        n.next = kNil;
+        n.level = static_cast<uint8_t>(level);
+        if (tail != kNil)
+        {
+            data_[tail].next = idx;
+        }
+        else
+        {
+            head_[level] = idx;
+            ready_ |= uint64_t{1} << level;
+        }
+        tail = idx;
+    }
+
+    constexpr void unlink(std::size_t id)
+    {
+        auto &n = data_[id];
+        auto const level = n.level;
+        if (n.prev != kNil)
+        {
+            data_[n.prev].next = n.next;
+        }
+        else
+        {
+            head_[level] = n.next;
+        }
+        if (n.next != kNil)
+        {
+            data_[n.next].prev = n.prev;
+        }
+        else
+        {
+            tail_[level] = n.prev;
+        }
+        if (head_[level] == kNil)
+        {
+            ready_ &= ~(uint64_t{1} << level);
+        }
+        n.prev = kNil;
+        n.next = kNil;
+        n.data = nullptr;
+    }
+
+    std::size_t size_{0};
+    uint16_t capacity_;
+    uint64_t ready_{0};
+    std::array<Index, Levels> head_ = make_nil_array();
+    std::array<Index, Levels> tail_ = make_nil_array();
+    std::array<Node, Capacity> data_{};
+};
+
+} // namespace fcp
+
+#endif // READY_QUEUE_HPP
@@ -0,0 +1,332 @@
+#ifndef SHARDED_TIMEOUT_QUEUE_HPP
+#define SHARDED_TIMEOUT_QUEUE_HPP
+
+#include "Platform.hpp"
+#include "Queue.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace fcp
+{
+
+/**
+ * @brief A fixed-capacity, thread-safe queue with O(1) random removal and no duplicate elements, split into
+ * independently locked shards by ID range.
+ *
+ * The ShardedTimeoutQueue class offers the TimeoutQueue operations with less lock contention:
+ * - ID-range shards: Shard `s` owns the contiguous IDs `s * kShardSpan .. (s + 1) * kShardSpan - 1`. Each shard has its
+ * own mutex and FIFO list on its own cache line, threaded through one shared ID-indexed node table.
+ * - `push()` and `remove()` lock only the shard that owns the element's ID.
+ * - Work-stealing `pop()`: A consumer takes the front of its home shard and visits the other shards in order when
+ * that one is empty. Shards that look empty are skipped without taking their lock.
+ * - Blocking pop with optional timeout: Consumers that find every shard empty wait on a single semaphore. Producers
+ * only touch the semaphore and its mutex when a consumer is actually waiting.
+ * - No dynamic memory allocation: All storage is preallocated based on the specified capacity.
+ *
+ * Ordering is FIFO per shard only; elements of different shards are popped in no particular order.
+ *
+ * @tparam T               The type of elements stored in the queue. Must provide `uint16_t GetId() const`.
+ * @tparam TMutex          Mutex type, used once per shard and once for the wait path.
+ * @tparam TSemaphore      Semaphore type for blocking operations.
+ * @tparam TMutexTrait     Trait class providing static lock/unlock/init for TMutex.
+ * @tparam TSemaphoreTrait Trait class providing static wait/notify/init for TSemaphore, with the same contract as for
+ *                         TimeoutQueue.
+ * @tparam Shards          Number of shards the ID range is split into.
+ * @tparam Capacity        Compile-time upper bound on the ID range. Defaults to the full `uint16_t` ID range.
+ */
+template <typename T, typename TMutex, typename TSemaphore, typename TMutexTrait, typename TSemaphoreTrait,
+          std::size_t Shards, std::size_t Capacity = Queue::kMaxCapacity>
+class ShardedTimeoutQueue : public Queue
+{
+    static_assert(std::is_same<decltype(std::declval<const T &>().GetId()), uint16_t>::value,
+                  "ShardedTimeoutQueue requires T to have a method `uint16_t GetId() const`");
+    static_assert(Capacity > 0 && Capacity <= Queue::kMaxCapacity,
+                  "ShardedTimeoutQueue Capacity must be in the range [1, Queue::kMaxCapacity]");
+    static_assert(Shards > 0 && Shards <= Capacity, "ShardedTimeoutQueue needs between 1 and Capacity shards");
+
+    using Status = Queue::Status;
+
+  public:
+    /// Number of consecutive IDs owned by each shard.
+    static constexpr std::size_t kShardSpan{(Capacity + Shards - 1) / Shards};
+
+    /**
+     * @brief Constructs a ShardedTimeoutQueue that accepts IDs below `capacity` (clamped to `Capacity`).
+     */
+    explicit ShardedTimeoutQueue(uint16_t capacity = Capacity)
+        : capacity_{static_cast<uint16_t>(std::min<std::size_t>(capacity, Capacity))}
+    {
+        for (auto &shard : shards_)
+        {
+            TMutexTrait::init(shard.mutex);
+        }
+        TMutexTrait::init(wait_mutex_);
+        TSemaphoreTrait::init(semaphore_);
+    }
+
+    ShardedTimeoutQueue(const ShardedTimeoutQueue &) = delete;
+    ShardedTimeoutQueue &operator=(const ShardedTimeoutQueue &) = delete;
+
+    ShardedTimeoutQueue(ShardedTimeoutQueue &&) = delete;
+    ShardedTimeoutQueue &operator=(ShardedTimeoutQueue &&) = delete;
+
+    /**
+     * @brief Returns the shard that owns `id`.
+     */
+    static constexpr std::size_t shard_of(uint16_t id)
+    {
+        return id / kShardSpan;
+    }
+
+    /**
+     * @brief Appends a container to the back of the shard that owns its ID.
+     *
+     * @return Status::Ok, Status::Full, Status::InvalidId or Status::Duplicate.
+     */
+    Status push(T &c)
+    {
+        auto const id = c.GetId();
+        if (!IdValid(id))
+        {
+            return Status::InvalidId;
+        }
+
+        auto &shard = shards_[shard_of(id)];
+        TMutexTrait::lock(shard.mutex);
+        auto &node = data_[id];
+        if (node)
+        {
+            TMutexTrait::unlock(shard.mutex);
+            // Every valid ID is queued when the queue is full, so fullness only needs checking on this path
+            return full() ? Status::Full : Status::Duplicate;
+        }
+        node.data = &c;
+        link(shard, id);
+        TMutexTrait::unlock(shard.mutex);
+
+        // Pairs with the waiter registration in pop(): either the consumer sees this element in its sweep, or this
+        // load sees the consumer.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) > 0)
+        {
+            // A registered consumer holds wait_mutex_ until it blocks, so the signal cannot fall in between
+            TMutexTrait::lock(wait_mutex_);
+            TMutexTrait::unlock(wait_mutex_);
+            TSemaphoreTrait::notify(semaphore_);
+        }
+
+        return Status::Ok;
+    }
+
+    /**
+     * @brief Removes and retrieves the front element of the home shard, or of the next non-empty shard after it.
+     *
+     * @param[out] out Reference to a pointer that will be set to the popped element.
+     * @param timeout_us Time to wait for an element: 0 returns immediately, a negative value waits forever.
+     * @param home Shard that is visited first, e.g. the one local to the calling thread. Taken modulo `Shards`.
+     * @return Status::Ok, or Status::Empty if every shard stayed empty.
+     */
+    Status pop(T *&out, long timeout_us = 0, std::size_t home = 0)
+    {
+        home %= Shards;
+
+        if (steal(out, home))
+        {
+            return Status::Ok;
+        }
+        if (timeout_us == 0)
+        {
+            return Status::Empty;
+        }
+
+        TMutexTrait::lock(wait_mutex_);
+        waiters_.fetch_add(1, std::memory_order_relaxed);
+        // Pairs with the fence in push() before the sweep reads the shard sizes
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto const ok = TSemaphoreTrait::wait(semaphore_, wait_mutex_, [this, &out, home] { return steal(out, home); },
+                                              timeout_us);
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        TMutexTrait::unlock(wait_mutex_);
+        if (ok)
+        {
+            return Status::Ok;
+        }
+        return Status::Empty;
+    }
+
+    /**
+     * @brief Removes the specified container, locking only the shard that owns its ID.
+     */
+    Status remove(T &c)
+    {
+        return remove(c.GetId());
+    }
+
+    Status remove(uint16_t id)
+    {
+        if (!IdValid(id))
+        {
+            return Status::InvalidId;
+        }
+
+        auto &shard = shards_[shard_of(id)];
+        TMutexTrait::lock(shard.mutex);
+        if (!data_[id])
+        {
+            TMutexTrait::unlock(shard.mutex);
+            return Status::NotFound;
+        }
+        unlink(shard, id);
+        TMutexTrait::unlock(shard.mutex);
+
+        return Status::Ok;
+    }
+
+    /**
+     * @brief Returns the number of elements in one shard. Lock-free and possibly stale, like `size()`.
+     */
+    std::size_t shard_size(std::size_t shard) const
+    {
+        return shards_[shard].size.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the number of queued elements without taking any lock; the value may be stale.
+     *
+     * Sums the shard counters, so it costs O(Shards) but keeps a shared counter off the push/pop path.
+     */
+    std::size_t size() const
+    {
+        std::size_t size = 0;
+        for (auto const &shard : shards_)
+        {
+            size += shard.size.load(std::memory_order_relaxed);
+        }
+        return size;
+    }
+
+    bool full() const
+    {
+        return size() == capacity_;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+  private:
+    static constexpr uint16_t kNil{std::numeric_limits<uint16_t>::max()};
+
+    struct Node
+    {
+        uint16_t prev{kNil};
+        uint16_t next{kNil};
+        T *data{nullptr};
+        constexpr operator bool() const
+        {
+            return data != nullptr;
+        }
+    };
+
+    // Everything one shard's producers and consumers write, kept off the cache lines of the other shards.
+    struct alignas(kCacheLineSize) Shard
+    {
+        TMutex mutex;
+        uint16_t head{kNil};
+        uint16_t tail{kNil};
+        // Written under `mutex`, read without it to skip empty shards
+        std::atomic<std::size_t> size{0};
+    };
+
+    bool IdValid(uint16_t id) const
+    {
+        return id < capacity_;
+    }
+
+    // Pops from the home shard, then from the following ones; shards that look empty are not locked.
+    bool steal(T *&out, std::size_t home)
+    {
+        for (std::size_t i = 0; i < Shards; ++i)
+        {
+            auto &shard = shards_[(home + i) % Shards];
+            if (shard.size.load(std::memory_order_relaxed) == 0)
+            {
+                continue;
+            }
+            TMutexTrait::lock(shard.mutex);
+            if (shard.head == kNil)
+            {
+                TMutexTrait::unlock(shard.mutex);
+                continue;
+            }
+            out = data_[shard.head].data;
+            unlink(shard, shard.head);
+            TMutexTrait::unlock(shard.mutex);
+            return true;
+        }
+        return false;
+    }
+
+    void link(Shard &shard, uint16_t id)
+    {
+        auto &n = data_[id];
+        n.prev = shard.tail;
+        n.next = kNil;
+        if (shard.tail != kNil)
+        {
+            data_[shard.tail].next = id;
+        }
+        else
+        {
+            shard.head = id;
+        }
+        shard.tail = id;
+        shard.size.store(shard.size.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void unlink(Shard &shard, uint16_t id)
+    {
+        auto &n = data_[id];
+        if (n.prev != kNil)
+        {
+            data_[n.prev].next = n.next;
+        }
+        else
+        {
+            shard.head = n.next;
+        }
+        if (n.next != kNil)
+        {
+            data_[n.next].prev = n.prev;
+        }
+        else
+        {
+            shard.tail = n.prev;
+        }
+        n.prev = kNil;
+        n.next = kNil;
+        n.data = nullptr;
+        shard.size.store(shard.size.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+    }
+
+    std::array<Shard, Shards> shards_;
+
+    uint16_t capacity_;
+
+    // Blocking path, only touched when a consumer finds every shard empty
+    alignas(kCacheLineSize) std::atomic<std::size_t> waiters_{0};
+    TMutex wait_mutex_;
+    TSemaphore semaphore_;
+
+    alignas(kCacheLineSize) std::array<Node, Capacity> data_;
+};
+
+} // namespace fcp
+
+#endif // SHARDED_TIMEOUT_QUEUE_HPP
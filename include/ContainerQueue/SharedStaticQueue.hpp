@@ -0,0 +1,305 @@
+#ifndef SHARED_STATIC_QUEUE_HPP
+#define SHARED_STATIC_QUEUE_HPP
+
+#include "Platform.hpp"
+#include "Queue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fcp
+{
+
+/**
+ * @brief A fixed-capacity single-producer/single-consumer ring buffer in a POSIX shared memory segment.
+ *
+ * SharedStaticQueue is the cross-process counterpart of SpscQueue: one process creates a named segment with
+ * `create()` and another maps the same ring with `open()`, after which one producer and one consumer exchange
+ * fixed-size records through the mapping, without sockets, serialization or system calls on the data path.
+ * - Versioned header: The segment starts with a magic number, a layout version and the capacity and element size it
+ *   was created for. `open()` rejects segments that do not match the instantiation exactly.
+ * - Atomic indices: Head and tail are free-running 64-bit counters on their own cache lines, published with
+ *   release/acquire ordering. They must be lock-free so they work across address spaces.
+ * - Each handle keeps a process-local copy of the other side's index and only reloads it when the ring looks full
+ *   (producer) or empty (consumer).
+ * - Elements are copied with `memcpy` straight into and out of the mapped slots, so `T` must be trivially copyable
+ *   and must not contain pointers that are meaningful in one process only.
+ *
+ * A handle unmaps the segment when it is destroyed; the name stays until `unlink()` is called, as with `shm_unlink`.
+ *
+ * @tparam T        The type of records stored in the queue. Must be trivially copyable.
+ * @tparam Capacity Maximum number of records in the queue.
+ */
+template <typename T, std::size_t Capacity> class SharedStaticQueue : public Queue
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SharedStaticQueue requires a trivially copyable T");
+    static_assert(Capacity > 0, "SharedStaticQueue requires a Capacity greater than zero");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                  "SharedStaticQueue needs lock-free 64-bit atomics to share indices between processes");
+
+    using Status = Queue::Status;
+
+  public:
+    /// Identifies a SharedStaticQueue segment ("FCPQ").
+    static constexpr uint32_t kMagic{0x46435051};
+    /// Layout version of the segment; bumped whenever the shared layout changes.
+    static constexpr uint32_t kVersion{1};
+
+    /**
+     * @brief Creates the named segment and initializes an empty ring in it.
+     *
+     * @param name Shared memory object name as for `shm_open`, e.g. "/records".
+     * @return The producer/consumer handle, or nothing if the name already exists or the segment cannot be mapped.
+     */
+    static std::optional<SharedStaticQueue> create(char const *name)
+    {
+        int const fd = ::shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+        {
+            return std::nullopt;
+        }
+        void *addr = MAP_FAILED;
+        if (::ftruncate(fd, sizeof(Region)) == 0)
+        {
+            addr = ::mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+        if (addr == MAP_FAILED)
+        {
+            ::shm_unlink(name);
+            return std::nullopt;
+        }
+
+        auto *const region = ::new (addr) Region{};
+        region->version = kVersion;
+        region->capacity = Capacity;
+        region->element_size = sizeof(T);
+        region->element_align = alignof(T);
+        // Published last, so open() never sees a half-initialized header
+        region->magic.store(kMagic, std::memory_order_release);
+
+        return SharedStaticQueue{region};
+    }
+
+    /**
+     * @brief Maps an existing segment created by `create()` of the same instantiation.
+     *
+     * @return The handle, or nothing if the name does not exist, is not initialized yet, or was created with a
+     *         different layout version, capacity or element size.
+     */
+    static std::optional<SharedStaticQueue> open(char const *name)
+    {
+        int const fd = ::shm_open(name, O_RDWR, 0600);
+        if (fd < 0)
+        {
+            return std::nullopt;
+        }
+        struct stat st = {};
+        void *addr = MAP_FAILED;
+        if (::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) == sizeof(Region))
+        {
+            addr = ::mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+        if (addr == MAP_FAILED)
+        {
+            return std::nullopt;
+        }
+
+        auto *const region = static_cast<Region *>(addr);
+        if (region->magic.load(std::memory_order_acquire) != kMagic || region->version != kVersion ||
+            region->capacity != Capacity || region->element_size != sizeof(T) ||
+            region->element_align != alignof(T))
+        {
+            ::munmap(addr, sizeof(Region));
+            return std::nullopt;
+        }
+
+        SharedStaticQueue queue{region};
+        queue.head_cache_ = region->head.load(std::memory_order_acquire);
+        queue.tail_cache_ = region->tail.load(std::memory_order_acquire);
+        return queue;
+    }
+
+    /**
+     * @brief Removes the segment name; mapped handles stay usable until they are destroyed.
+     */
+    static bool unlink(char const *name)
+    {
+        return ::shm_unlink(name) == 0;
+    }
+
+    ~SharedStaticQueue()
+    {
+        if (region_ != nullptr)
+        {
+            ::munmap(region_, sizeof(Region));
+        }
+    }
+
+    SharedStaticQueue(const SharedStaticQueue &) = delete;
+    SharedStaticQueue &operator=(const SharedStaticQueue &) = delete;
+
+    SharedStaticQueue(SharedStaticQueue &&other) noexcept
+        : region_{std::exchange(other.region_, nullptr)}, head_cache_{other.head_cache_},
+          tail_cache_{other.tail_cache_}
+    {
+    }
+    SharedStaticQueue &operator=(SharedStaticQueue &&other) noexcept
+    {
+        if (this != &other)
+        {
+            if (region_ != nullptr)
+            {
+                ::munmap(region_, sizeof(Region));
+            }
+            region_ = std::exchange(other.region_, nullptr);
+            head_cache_ = other.head_cache_;
+            tail_cache_ = other.tail_cache_;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Appends a record. Must only be called by the single producer.
+     *
+     * @return Status::Ok on success, Status::Full if the ring is full.
+     */
+    Status push(T const &element)
+    {
+        return push_n(std::span<T const>(&element, 1)) == 1 ? Status::Ok : Status::Full;
+    }
+
+    /**
+     * @brief Removes the oldest record. Must only be called by the single consumer.
+     *
+     * @return Status::Ok on success, Status::Empty if the ring is empty.
+     */
+    Status pop(T &out)
+    {
+        return pop_n(std::span<T>(&out, 1)) == 1 ? Status::Ok : Status::Empty;
+    }
+
+    /**
+     * @brief Appends as many records of the range as fit and publishes them at once; returns how many were pushed.
+     *
+     * The records are copied as at most two contiguous chunks (before and after the wrap point).
+     */
+    std::size_t push_n(std::span<T const> elements)
+    {
+        auto const tail = region_->tail.load(std::memory_order_relaxed);
+        if (tail - head_cache_ + elements.size() > Capacity)
+        {
+            head_cache_ = region_->head.load(std::memory_order_acquire);
+        }
+        auto const n = std::min<std::size_t>(elements.size(), Capacity - (tail - head_cache_));
+        if (n == 0)
+        {
+            return 0;
+        }
+
+        auto const pos = static_cast<std::size_t>(tail % Capacity);
+        auto const first = std::min(n, Capacity - pos);
+        std::memcpy(slot(pos), elements.data(), first * sizeof(T));
+        std::memcpy(slot(0), elements.data() + first, (n - first) * sizeof(T));
+        region_->tail.store(tail + n, std::memory_order_release);
+
+        return n;
+    }
+
+    /**
+     * @brief Removes up to `out.size()` records in FIFO order into `out`; returns how many were popped.
+     */
+    std::size_t pop_n(std::span<T> out)
+    {
+        auto const head = region_->head.load(std::memory_order_relaxed);
+        if (tail_cache_ - head < out.size())
+        {
+            tail_cache_ = region_->tail.load(std::memory_order_acquire);
+        }
+        auto const n = std::min<std::size_t>(out.size(), tail_cache_ - head);
+        if (n == 0)
+        {
+            return 0;
+        }
+
+        auto const pos = static_cast<std::size_t>(head % Capacity);
+        auto const first = std::min(n, Capacity - pos);
+        std::memcpy(static_cast<void *>(out.data()), slot(pos), first * sizeof(T));
+        std::memcpy(static_cast<void *>(out.data() + first), slot(0), (n - first) * sizeof(T));
+        region_->head.store(head + n, std::memory_order_release);
+
+        return n;
+    }
+
+    /**
+     * @brief Returns the number of queued records.
+     *
+     * @note When called concurrently with `push`/`pop` the result is a snapshot that may already be stale.
+     */
+    std::size_t size() const
+    {
+        auto const head = region_->head.load(std::memory_order_acquire);
+        auto const tail = region_->tail.load(std::memory_order_acquire);
+        return static_cast<std::size_t>(std::min<uint64_t>(tail - head, Capacity));
+    }
+
+    bool full() const
+    {
+        return size() == Capacity;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+  private:
+    // The shared segment. Only fixed-width fields, so producer and consumer agree on the layout.
+    struct Region
+    {
+        std::atomic<uint32_t> magic{0};
+        uint32_t version{0};
+        uint64_t capacity{0};
+        uint32_t element_size{0};
+        uint32_t element_align{0};
+
+        // Written by the consumer
+        alignas(kCacheLineSize) std::atomic<uint64_t> head{0};
+        // Written by the producer
+        alignas(kCacheLineSize) std::atomic<uint64_t> tail{0};
+
+        // Raw slots; records only ever enter and leave them through memcpy
+        alignas(kCacheLineSize) alignas(T) unsigned char data[Capacity * sizeof(T)];
+    };
+
+    explicit SharedStaticQueue(Region *region) : region_{region}
+    {
+    }
+
+    void *slot(std::size_t pos)
+    {
+        return region_->data + pos * sizeof(T);
+    }
+
+    Region *region_;
+    // Process-local copies of the other side's index
+    uint64_t head_cache_{0};
+    uint64_t tail_cache_{0};
+};
+
+} // namespace fcp
+
+#endif // SHARED_STATIC_QUEUE_HPP
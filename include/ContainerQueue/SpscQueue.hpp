@@ -0,0 +1,128 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include "Platform.hpp"
+#include "Queue.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace fcp
+{
+
+/**
+ * @brief A fixed-capacity, lock-free single-producer/single-consumer ring buffer.
+ *
+ * SpscQueue offers the `push`/`pop` API of StaticQueue, but may be used by exactly one producer thread and one
+ * consumer thread at the same time without any external locking:
+ * - The producer owns the tail index and the consumer owns the head index. Each index lives on its own cache line
+ *   and is published with release/acquire ordering; there is no element counter written by both sides.
+ * - Each side keeps a private copy of the other side's index and only reloads it when the ring looks full (producer)
+ *   or empty (consumer), so the common case touches no shared cache line besides the element slot.
+ * - No dynamic memory allocation: All storage is preallocated based on the specified capacity.
+ *
+ * @tparam T        The type of elements stored in the queue. Must be default-constructible and copy-assignable.
+ * @tparam Capacity Maximum number of elements in the queue.
+ */
+template <typename T, std::size_t Capacity> class SpscQueue : public Queue
+{
+    static_assert(Capacity > 0, "SpscQueue requires a Capacity greater than zero");
+
+    using Status = Queue::Status;
+
+  public:
+    SpscQueue() = default;
+    ~SpscQueue() = default;
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    SpscQueue(SpscQueue &&) = delete;
+    SpscQueue &operator=(SpscQueue &&) = delete;
+
+    /**
+     * @brief Appends an element. Must only be called from the producer thread.
+     *
+     * @param element The element to copy into the queue.
+     * @return Status::Ok on success, Status::Full if the queue is full.
+     */
+    Status push(T const &element)
+    {
+        auto const tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ == Capacity)
+        {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ == Capacity)
+            {
+                return Status::Full;
+            }
+        }
+
+        data_[tail % Capacity] = element;
+        tail_.store(tail + 1, std::memory_order_release);
+
+        return Status::Ok;
+    }
+
+    /**
+     * @brief Removes the oldest element. Must only be called from the consumer thread.
+     *
+     * @param[out] out Receives the removed element.
+     * @return Status::Ok on success, Status::Empty if the queue is empty.
+     */
+    Status pop(T &out)
+    {
+        auto const head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_)
+        {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_)
+            {
+                return Status::Empty;
+            }
+        }
+
+        out = data_[head % Capacity];
+        head_.store(head + 1, std::memory_order_release);
+
+        return Status::Ok;
+    }
+
+    /**
+     * @brief Returns the number of queued elements.
+     *
+     * @note When called concurrently with `push`/`pop` the result is a snapshot that may already be stale.
+     */
+    std::size_t size() const
+    {
+        auto const head = head_.load(std::memory_order_acquire);
+        auto const tail = tail_.load(std::memory_order_acquire);
+        return std::min<std::size_t>(tail - head, Capacity);
+    }
+
+    bool full() const
+    {
+        return size() == Capacity;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+  private:
+    // Written by the consumer, read by the producer when it refreshes head_cache_.
+    alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};
+    std::size_t tail_cache_{0};
+
+    // Written by the producer, read by the consumer when it refreshes tail_cache_.
+    alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};
+    std::size_t head_cache_{0};
+
+    alignas(kCacheLineSize) std::array<T, Capacity> data_{};
+};
+
+} // namespace fcp
+
+#endif // SPSC_QUEUE_HPP
@@ -2,71 +2,399 @@
 #define STATICQUEUE_HPP
 
 #include "Queue.hpp"
+#include "QueueStats.hpp"
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
 
 namespace fcp
 {
-template <typename T, std::size_t Capacity> class StaticQueue : public Queue
+namespace detail
+{
+/**
+ * @brief Read/write cursors of a ring buffer with `Capacity` slots.
+ *
+ * The general version keeps wrapped head/tail indices plus an element count. When `Capacity` is a power of two the
+ * specialization below keeps free-running counters instead: slot indices are a mask away and the size is
+ * `tail - head`, so there is neither a modulo nor a separate counter to update.
+ */
+template <std::size_t Capacity, bool = std::has_single_bit(Capacity)> class RingCursor
+{
+  public:
+    static constexpr std::size_t wrap(std::size_t i)
+    {
+        return i % Capacity;
+    }
+    constexpr std::size_t size() const
+    {
+        return size_;
+    }
+    constexpr std::size_t head() const
+    {
+        return head_;
+    }
+    constexpr std::size_t tail() const
+    {
+        return tail_;
+    }
+    constexpr void advance_head(std::size_t n)
+    {
+        size_ -= n;
+        head_ = wrap(head_ + n);
+    }
+    constexpr void advance_tail(std::size_t n)
+    {
+        size_ += n;
+        tail_ = wrap(tail_ + n);
+    }
+
+  private:
+    std::size_t size_{0};
+    std::size_t tail_{0};
+    std::size_t head_{0};
+};
+
+template <std::size_t Capacity> class RingCursor<Capacity, true>
+{
+  public:
+    static constexpr std::size_t wrap(std::size_t i)
+    {
+        return i & (Capacity - 1);
+    }
+    constexpr std::size_t size() const
+    {
+        return tail_ - head_;
+    }
+    constexpr std::size_t head() const
+    {
+        return wrap(head_);
+    }
+    constexpr std::size_t tail() const
+    {
+        return wrap(tail_);
+    }
+    constexpr void advance_head(std::size_t n)
+    {
+        head_ += n;
+    }
+    constexpr void advance_tail(std::size_t n)
+    {
+        tail_ += n;
+    }
+
+  private:
+    std::size_t tail_{0};
+    std::size_t head_{0};
+};
+} // namespace detail
+
+/**
+ * @brief A fixed-capacity FIFO ring buffer without dynamic memory allocation.
+ *
+ * Elements live in raw, suitably aligned slots and are only constructed while they are queued, so `T` does not need
+ * to be default-constructible and move-only types are supported. For trivially copyable and trivially destructible
+ * `T` the queue itself stays trivially copyable and destructible.
+ *
+ * Power-of-two capacities use masked free-running cursors and no element counter; see `StaticQueuePow2` to round a
+ * capacity up to the next power of two.
+ *
+ * @tparam T        The type of elements stored in the queue.
+ * @tparam Capacity Maximum number of elements in the queue.
+ * @tparam TStats   Statistics policy, see `NoStats` and `QueueStats`. A counting policy is copied along with the
+ *                  queue but makes it non-trivially copyable.
+ */
+template <typename T, std::size_t Capacity, typename TStats = NoStats> class StaticQueue : public Queue
 {
     using Status = Queue::Status;
 
   public:
     constexpr StaticQueue() = default;
-    constexpr ~StaticQueue() = default;
-    constexpr StaticQueue(const StaticQueue &) = default;
-    constexpr StaticQueue(StaticQueue &&) = default;
-    constexpr StaticQueue &operator=(const StaticQueue &) = default;
-    constexpr StaticQueue &operator=(StaticQueue &&) = default;
+
+    constexpr ~StaticQueue()
+        requires std::is_trivially_destructible_v<T>
+    = default;
+    constexpr ~StaticQueue()
+    {
+        reset();
+    }
+
+    constexpr StaticQueue(const StaticQueue &)
+        requires std::is_trivially_copyable_v<T>
+    = default;
+    constexpr StaticQueue(const StaticQueue &other)
+    {
+        copy_from(other);
+    }
+
+    constexpr StaticQueue(StaticQueue &&)
+        requires std::is_trivially_copyable_v<T>
+    = default;
+    constexpr StaticQueue(StaticQueue &&other)
+    {
+        move_from(other);
+    }
+
+    constexpr StaticQueue &operator=(const StaticQueue &)
+        requires std::is_trivially_copyable_v<T>
+    = default;
+    constexpr StaticQueue &operator=(const StaticQueue &other)
+    {
+        if (this != &other)
+        {
+            reset();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    constexpr StaticQueue &operator=(StaticQueue &&)
+        requires std::is_trivially_copyable_v<T>
+    = default;
+    constexpr StaticQueue &operator=(StaticQueue &&other)
+    {
+        if (this != &other)
+        {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
 
     constexpr Status push(T const &element)
+    {
+        return emplace(element);
+    }
+
+    constexpr Status push(T &&element)
+    {
+        return emplace(std::move(element));
+    }
+
+    /**
+     * @brief Constructs an element in place at the back of the queue.
+     *
+     * @param args Arguments forwarded to the constructor of `T`.
+     * @return Status::Ok on success, Status::Full if the queue is full.
+     */
+    template <typename... Args> constexpr Status emplace(Args &&...args)
     {
         if (full())
         {
+            stats_.on_reject(Status::Full);
             return Status::Full;
         }
 
-        data_[tail_] = element;
-        size_++;
-        tail_ = (tail_ + 1) % Capacity;
+        std::construct_at(&data_[cursor_.tail()].value, std::forward<Args>(args)...);
+        cursor_.advance_tail(1);
+        stats_.on_push(1, size());
 
         return Status::Ok;
     }
 
+    /**
+     * @brief Moves the front element into `out` and destroys its slot.
+     */
     constexpr Status pop(T &out)
     {
         if (empty())
         {
+            stats_.on_reject(Status::Empty);
             return Status::Empty;
         }
 
-        out = data_[head_];
-        size_--;
-        head_ = (head_ + 1) % Capacity;
+        auto &slot = data_[cursor_.head()];
+        out = std::move(slot.value);
+        std::destroy_at(&slot.value);
+        cursor_.advance_head(1);
+        stats_.on_pop(1);
 
         return Status::Ok;
     }
 
+    /**
+     * @brief Appends as many elements of the range as fit; returns how many were pushed.
+     *
+     * The range is copied as at most two contiguous chunks (before and after the wrap point), each a single `memcpy`
+     * for trivially copyable `T`.
+     */
+    constexpr std::size_t push_n(std::span<T const> elements)
+    {
+        auto const n = std::min(elements.size(), Capacity - size());
+        auto const tail = cursor_.tail();
+        auto const first = std::min(n, Capacity - tail);
+
+        copy_in(tail, elements.data(), first);
+        copy_in(0, elements.data() + first, n - first);
+        cursor_.advance_tail(n);
+        stats_.on_push(n, size());
+        if (n < elements.size())
+        {
+            stats_.on_reject(Status::Full);
+        }
+
+        return n;
+    }
+
+    /**
+     * @brief Moves up to `out.size()` elements in FIFO order into `out`; returns how many were popped.
+     */
+    constexpr std::size_t pop_n(std::span<T> out)
+    {
+        auto const n = std::min(out.size(), size());
+        auto const head = cursor_.head();
+        auto const first = std::min(n, Capacity - head);
+
+        move_out(head, out.data(), first);
+        move_out(0, out.data() + first, n - first);
+        cursor_.advance_head(n);
+        stats_.on_pop(n);
+        if (n == 0 && !out.empty())
+        {
+            stats_.on_reject(Status::Empty);
+        }
+
+        return n;
+    }
+
+    /**
+     * @brief Destroys all queued elements.
+     */
+    constexpr void clear()
+    {
+        stats_.on_remove(size());
+        reset();
+    }
+
     constexpr std::size_t size() const
     {
-        return size_;
+        return cursor_.size();
     }
 
     constexpr bool full() const
     {
-        return size_ == Capacity;
+        return size() == Capacity;
     }
 
     constexpr bool empty() const
     {
-        return size_ == 0;
+        return size() == 0;
+    }
+
+    /**
+     * @brief Returns the statistics policy, e.g. for `stats().snapshot()` with `QueueStats`.
+     */
+    constexpr TStats const &stats() const
+    {
+        return stats_;
     }
 
   private:
-    std::size_t size_{0};
-    std::size_t tail_{0};
-    std::size_t head_{0};
-    std::array<T, Capacity> data_;
+    using Cursor = detail::RingCursor<Capacity>;
+
+    // Uninitialized storage for one element; `value` is only alive while the slot is occupied.
+    union Slot
+    {
+        constexpr Slot()
+        {
+        }
+        constexpr ~Slot()
+            requires std::is_trivially_destructible_v<T>
+        = default;
+        constexpr ~Slot()
+        {
+        }
+
+        T value;
+    };
+
+    constexpr void copy_in(std::size_t pos, T const *src, std::size_t n)
+    {
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                if (n > 0)
+                {
+                    std::memcpy(static_cast<void *>(&data_[pos]), src, n * sizeof(T));
+                }
+                return;
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            std::construct_at(&data_[pos + i].value, src[i]);
+        }
+    }
+
+    constexpr void move_out(std::size_t pos, T *dst, std::size_t n)
+    {
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                if (n > 0)
+                {
+                    std::memcpy(static_cast<void *>(dst), &data_[pos], n * sizeof(T));
+                }
+                return;
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            dst[i] = std::move(data_[pos + i].value);
+            std::destroy_at(&data_[pos + i].value);
+        }
+    }
+
+    constexpr void reset()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            for (std::size_t i = 0; i < size(); ++i)
+            {
+                std::destroy_at(&data_[Cursor::wrap(cursor_.head() + i)].value);
+            }
+        }
+        cursor_ = Cursor{};
+    }
+
+    constexpr void copy_from(StaticQueue const &other)
+    {
+        for (std::size_t i = 0; i < other.size(); ++i)
+        {
+            auto const pos = Cursor::wrap(other.cursor_.head() + i);
+            std::construct_at(&data_[pos].value, other.data_[pos].value);
+        }
+        cursor_ = other.cursor_;
+        stats_ = other.stats_;
+    }
+
+    constexpr void move_from(StaticQueue &other)
+    {
+        for (std::size_t i = 0; i < other.size(); ++i)
+        {
+            auto const pos = Cursor::wrap(other.cursor_.head() + i);
+            std::construct_at(&data_[pos].value, std::move(other.data_[pos].value));
+        }
+        cursor_ = other.cursor_;
+        stats_ = other.stats_;
+        other.reset();
+    }
+
+    Cursor cursor_;
+    std::array<Slot, Capacity> data_;
+    [[no_unique_address]] TStats stats_;
 };
+
+/**
+ * @brief StaticQueue with at least `MinCapacity` slots, rounded up to a power of two for the masked fast path.
+ */
+template <typename T, std::size_t MinCapacity> using StaticQueuePow2 = StaticQueue<T, std::bit_ceil(MinCapacity)>;
 } // namespace fcp
 
-#endif // STATICQUEUE_HPP
\ No newline at end of file
+#endif // STATICQUEUE_HPP
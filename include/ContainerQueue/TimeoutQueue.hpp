@@ -1,11 +1,20 @@
 #ifndef TIMEOUT_QUEUE_HPP
 #define TIMEOUT_QUEUE_HPP
 
+#include "IndexPolicy.hpp"
+#include "Platform.hpp"
 #include "Queue.hpp"
+#include "QueueStats.hpp"
+#include "TimerWheel.hpp"
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
 #include <cstdint>
 #include <limits>
+#include <span>
+#include <type_traits>
 #include <utility>
 
 namespace fcp
@@ -15,42 +24,214 @@ namespace fcp
  * @brief A fixed-capacity, thread-safe queue with O(1) random removal and no duplicate elements.
  *
  * The TimeoutQueue class provides a queue-like container with the following features:
- * - No duplicate elements: Each element is uniquely identified by its `GetId()` method, and only one instance of each
- * ID can exist in the queue at a time.
+ * - No duplicate elements: Each element is uniquely identified by its key (by default its `GetId()` method), and only
+ * one instance of each ID can exist in the queue at a time.
  * - O(1) random removal: Elements can be removed from any position in the queue in constant time using their ID.
  * - No dynamic memory allocation: All storage is preallocated based on the specified capacity.
- * - Thread safety: All operations are protected by user-supplied mutex and semaphore types/traits.
- * - Supports blocking pop operations with optional timeout.
+ * - Thread safety: All operations are protected by user-supplied mutex and semaphore types/traits, except the
+ * `size()`, `empty()` and `full()` observers, which read a relaxed atomic mirror of the element count.
+ * - Supports blocking pop and push operations with optional timeout. Pops can first spin on a lock-free size mirror
+ * before parking the thread in the semaphore; pushes to a full queue wait for space on a second semaphore.
+ * - Optional per-element deadlines: With a `TimerWheel` as `TTimer`, `push(c, Deadline{t})` arms an O(1) timer for
+ * the element that is cancelled by `pop`/`remove`, and `expire()`/`pop_expired()` drain the elements whose deadline
+ * has passed.
+ * - Coroutine support: `co_await async_pop(out)` and `co_await async_push(c)` suspend the calling coroutine instead of
+ * a thread. Suspended coroutines are kept in intrusive waiter lists inside the queue and are resumed directly by the
+ * operation that satisfies them, after it has released the lock.
+ * - Optional statistics: With `QueueStats<>` as `TStats`, the queue counts its operations and rejections; with
+ * `QueueStats<true>` it also records lock hold and pop wait times. Both are readable at any time through
+ * `stats().snapshot()`.
  *
- * @tparam T               The type of elements stored in the queue. Must provide `uint16_t GetId() const`.
+ * @tparam T               The type of elements stored in the queue. With the default key trait it must provide an
+ *                         unsigned `GetId() const`.
  * @tparam TMutex          Mutex type for thread safety.
  * @tparam TSemaphore      Semaphore type for blocking operations.
  * @tparam TMutexTrait     Trait class providing static lock/unlock/init for TMutex.
- * @tparam TSemaphoreTrait Trait class providing static wait/notify/init for TSemaphore.
+ * @tparam TSemaphoreTrait Trait class providing static wait/notify/init for TSemaphore, and optionally
+ *                         `notify_all(TSemaphore &)` to wake every blocked consumer with a single call.
+ *                         `wait(sem, mutex, pred, timeout_us)` is called with the mutex held and must return with it
+ *                         held: it may only release the mutex while the thread sleeps, so `pred` is always evaluated
+ *                         and the element extracted under the same lock. It returns whether `pred()` holds.
+ * @tparam Capacity        Compile-time upper bound on the ID range. Node storage is sized by this value, so small
+ *                         queues should set it close to the capacity passed to the constructor. Defaults to the
+ *                         full `uint16_t` ID range; larger values need a key trait with a wider key type. The links
+ *                         use the smallest index type that fits (see `LinkIndex`).
+ * @tparam TTimer          `NoTimer` (default) or `TimerWheel<Capacity>` to enable per-element deadlines.
+ * @tparam TKey            Key trait providing `static Key key(T const &)`, see `GetIdKey`.
+ * @tparam TStats          Statistics policy, see `NoStats` (default) and `QueueStats`.
  *
  * Typical use cases include resource pools, task queues, or any scenario where fast, thread-safe, duplicate-free
  * queueing with random removal is required.
  */
-template <typename T, typename TMutex, typename TSemaphore, typename TMutexTrait, typename TSemaphoreTrait>
+template <typename T, typename TMutex, typename TSemaphore, typename TMutexTrait, typename TSemaphoreTrait,
+          std::size_t Capacity = Queue::kMaxCapacity, typename TTimer = NoTimer, typename TKey = GetIdKey,
+          typename TStats = NoStats>
 class TimeoutQueue : public Queue
 {
-    static_assert(std::is_same<decltype(std::declval<const T &>().GetId()), uint16_t>::value,
-                  "TimeoutQueue requires T to have a method `uint16_t GetId() const`");
+    using Key = KeyType<TKey, T>;
+
+    static constexpr bool kHasTimer{!std::is_same_v<TTimer, NoTimer>};
+    static constexpr bool kHasNotifyAll{requires(TSemaphore &s) { TSemaphoreTrait::notify_all(s); }};
+
+    static_assert(std::is_integral_v<Key> && std::is_unsigned_v<Key>,
+                  "TimeoutQueue requires the key trait to return an unsigned integer ID");
+    static_assert(Capacity > 0 && Capacity - 1 <= std::numeric_limits<Key>::max(),
+                  "TimeoutQueue Capacity must be at least 1 and within the range of the key type");
+    static_assert(TTimer::kCapacity >= Capacity, "TimeoutQueue TTimer must cover every ID");
 
     using Status = Queue::Status;
 
+    struct WaiterList;
+
+    // A suspended coroutine, embedded in the awaiter that lives in its coroutine frame.
+    struct Waiter
+    {
+        Waiter *prev{nullptr};
+        Waiter *next{nullptr};
+        // List the waiter is linked into, null while it is not suspended on the queue
+        WaiterList *list{nullptr};
+        std::coroutine_handle<> handle;
+        T *element{nullptr};
+        uint64_t deadline{std::numeric_limits<uint64_t>::max()};
+        Status status{Status::Ok};
+    };
+
+    struct WaiterList
+    {
+        Waiter *head{nullptr};
+        Waiter *tail{nullptr};
+    };
+
   public:
+    using value_type = T;
+    using Mutex = TMutex;
+    using Semaphore = TSemaphore;
+    using MutexTrait = TMutexTrait;
+    using SemaphoreTrait = TSemaphoreTrait;
+
+    /**
+     * @brief Callback registered with `set_push_listener()`, e.g. by a `QueueSet`.
+     *
+     * `on_push(context, added)` runs on the pushing thread after the lock has been released, whenever an operation
+     * left `added > 0` new elements in the queue (elements handed straight to suspended coroutines do not count).
+     */
+    struct PushListener
+    {
+        void (*on_push)(void *context, std::size_t added);
+        void *context;
+    };
+
+    /**
+     * @brief Awaitable returned by `async_pop()`; `co_await` yields the Status and sets `out` on success.
+     *
+     * Destroying a suspended coroutine removes its waiter from the queue.
+     */
+    class PopAwaiter
+    {
+      public:
+        PopAwaiter(const PopAwaiter &) = delete;
+        PopAwaiter &operator=(const PopAwaiter &) = delete;
+
+        ~PopAwaiter()
+        {
+            queue_.cancel(waiter_);
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            return queue_.suspend_pop(waiter_, handle);
+        }
+
+        Status await_resume() noexcept
+        {
+            if (waiter_.status == Status::Ok)
+            {
+                out_ = waiter_.element;
+            }
+            return waiter_.status;
+        }
+
+      private:
+        friend class TimeoutQueue;
+
+        PopAwaiter(TimeoutQueue &queue, T *&out, uint64_t deadline) : queue_{queue}, out_{out}
+        {
+            waiter_.deadline = deadline;
+        }
+
+        TimeoutQueue &queue_;
+        T *&out_;
+        Waiter waiter_;
+    };
+
+    /**
+     * @brief Awaitable returned by `async_push()`; `co_await` yields the Status of the push.
+     *
+     * Destroying a suspended coroutine removes its waiter from the queue.
+     */
+    class PushAwaiter
+    {
+      public:
+        PushAwaiter(const PushAwaiter &) = delete;
+        PushAwaiter &operator=(const PushAwaiter &) = delete;
+
+        ~PushAwaiter()
+        {
+            queue_.cancel(waiter_);
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            return queue_.suspend_push(waiter_, handle);
+        }
+
+        Status await_resume() const noexcept
+        {
+            return waiter_.status;
+        }
+
+      private:
+        friend class TimeoutQueue;
+
+        PushAwaiter(TimeoutQueue &queue, T &c, uint64_t deadline) : queue_{queue}
+        {
+            waiter_.element = &c;
+            waiter_.deadline = deadline;
+        }
+
+        TimeoutQueue &queue_;
+        Waiter waiter_;
+    };
+
+    /// Upper bound on the `cpu_relax()` calls of a single spin round.
+    static constexpr std::size_t kMaxBackoff{64};
+
     /**
      * @brief Constructs a TimeoutQueue with the specified capacity.
      *
      * Initializes the TimeoutQueue to hold up to the given number of elements.
      *
-     * @param capacity The maximum number of elements the queue can hold.
+     * @param capacity The maximum number of elements the queue can hold. Values above `Capacity` are clamped to
+     *                 `Capacity`.
+     * @param spin_count Number of backoff rounds a blocking pop polls for an element before waiting on the
+     *                   semaphore; 0 disables spinning. See `set_spin_count()`.
      */
-    explicit TimeoutQueue(uint16_t capacity) : capacity_{capacity}
+    explicit TimeoutQueue(std::size_t capacity = Capacity, uint32_t spin_count = 0)
+        : capacity_{std::min(capacity, Capacity)}, spin_count_{spin_count}
     {
         TMutexTrait::init(mutex_);
         TSemaphoreTrait::init(semaphore_);
+        TSemaphoreTrait::init(space_semaphore_);
     }
 
     TimeoutQueue(const TimeoutQueue &) = delete;
@@ -72,43 +253,171 @@ class TimeoutQueue : public Queue
      */
     Status push(T &c)
     {
-        TMutexTrait::lock(mutex_);
+        Guard guard{*this};
+        auto const status = push_impl(c);
+        auto const wakeup = settle(status == Status::Ok ? 1 : 0, 0);
+        guard.unlock();
 
-        if (full_impl())
+        notify(wakeup);
+
+        return status;
+    }
+
+    /**
+     * @brief Pushes a container into the queue, waiting for free space if it is full.
+     *
+     * Producers block on a second semaphore that `pop`, `remove` and the other removing operations signal, so a full
+     * queue applies backpressure instead of forcing a retry loop. The element is checked once space is available: as
+     * every valid ID is queued while the queue is full, a push whose own ID is still queued then returns
+     * Status::Duplicate.
+     *
+     * @param c Reference to the container to be pushed into the queue.
+     * @param timeout_us Time to wait for space: 0 returns immediately, a negative value waits forever.
+     * @return Status::Timeout if the queue stayed full (Status::Full for a zero timeout), otherwise the result of
+     *         `push(T &)`.
+     */
+    Status push(T &c, long timeout_us)
+    {
+        Guard guard{*this};
+        if (!wait_until(space_semaphore_, space_waiters_, [this] { return !full_impl(); }, timeout_us))
         {
-            TMutexTrait::unlock(mutex_);
-            return Status::Full;
+            guard.unlock();
+            stats_.on_reject(Status::Full);
+            return timeout_us == 0 ? Status::Full : Status::Timeout;
         }
 
-        auto const id = c.GetId();
+        auto const status = push_impl(c);
+        auto const wakeup = settle(status == Status::Ok ? 1 : 0, 0);
+        guard.unlock();
 
-        if (!IdValid(id))
+        notify(wakeup);
+
+        return status;
+    }
+
+    /**
+     * @brief Pushes a container into the queue and arms its deadline.
+     *
+     * The timer is cancelled when the element leaves the queue through `pop`, `remove` or expiry.
+     *
+     * @param c Reference to the container to be pushed into the queue.
+     * @param deadline Absolute tick at which the element expires, in the unit passed to `expire()`.
+     * @return Status indicating the result of the push operation, as for `push(T &)`.
+     */
+    Status push(T &c, Deadline deadline)
+        requires kHasTimer
+    {
+        Guard guard{*this};
+        auto const status = push_impl(c);
+        if (status == Status::Ok)
         {
-            TMutexTrait::unlock(mutex_);
-            return Status::InvalidId;
+            timer_.schedule(TKey::key(c), deadline.ticks);
         }
+        auto const wakeup = settle(status == Status::Ok ? 1 : 0, 0);
+        guard.unlock();
 
-        auto &node = data_[id];
+        notify(wakeup);
+
+        return status;
+    }
+
+    /**
+     * @brief Removes every element whose deadline is at or before `now` and passes it to `callback`.
+     *
+     * Elements are handed out under a single lock. Elements that become due in the same call may be handed out in any
+     * order, not necessarily by deadline.
+     *
+     * @param now Current time in ticks. Time never goes backwards; an older `now` expires nothing new.
+     * @param callback Invoked as `callback(T &)` for each expired element while the queue is locked. It must not call
+     *                 back into the queue.
+     * @return Number of expired elements.
+     */
+    template <typename Callback>
+    std::size_t expire(uint64_t now, Callback &&callback)
+        requires kHasTimer
+    {
+        std::size_t n = 0;
 
-        if (node)
+        Guard guard{*this};
+        timer_.advance(now);
+        std::size_t id = 0;
+        while (timer_.pop_due(id))
         {
-            TMutexTrait::unlock(mutex_);
-            return Status::Duplicate;
+            auto *const c = data_[id].data;
+            unlink(data_[id]);
+            set_size(size_impl() - 1);
+            callback(*c);
+            ++n;
         }
+        stats_.on_remove(n);
+        auto const wakeup = settle(0, n);
+        guard.unlock();
 
-        // Fill node with data
-        node.data = &c;
+        notify(wakeup);
 
-        // Link the next and prev
-        link(node);
-        size_++;
+        return n;
+    }
 
-        TMutexTrait::unlock(mutex_);
-        TSemaphoreTrait::notify(semaphore_);
+    /**
+     * @brief Removes and retrieves one element whose deadline is at or before `now`.
+     *
+     * @param now Current time in ticks.
+     * @param[out] out Reference to a pointer that will be set to the expired element.
+     * @return Status::Ok, or Status::Empty if no element has expired.
+     */
+    Status pop_expired(uint64_t now, T *&out)
+        requires kHasTimer
+    {
+        Guard guard{*this};
+        timer_.advance(now);
+        std::size_t id = 0;
+        if (!timer_.pop_due(id))
+        {
+            return Status::Empty;
+        }
+        out = data_[id].data;
+        unlink(data_[id]);
+        set_size(size_impl() - 1);
+        stats_.on_remove(1);
+        auto const wakeup = settle(0, 1);
+        guard.unlock();
+
+        notify(wakeup);
 
         return Status::Ok;
     }
 
+    /**
+     * @brief Pushes the elements of the range in order under a single lock.
+     *
+     * Pushing stops at the first element that is null or rejected (full, duplicate or invalid ID). Wakes as many
+     * blocked consumers as there are new elements, through a single `notify_all` if the trait provides one.
+     *
+     * @param elements Pointers to the containers to be pushed into the queue.
+     * @return Number of elements pushed. If it is less than `elements.size()`, the element at that index and all
+     *         following elements were not pushed.
+     */
+    std::size_t push_n(std::span<T *const> elements)
+    {
+        std::size_t n = 0;
+
+        Guard guard{*this};
+        for (auto *c : elements)
+        {
+            if (c == nullptr || push_impl(*c) != Status::Ok)
+            {
+                break;
+            }
+            ++n;
+        }
+        auto const wakeup = settle(n, 0);
+        guard.unlock();
+
+        notify(wakeup);
+
+        return n;
+    }
+
     /**
      * @brief Retrieves, but does not remove, the front element of the queue.
      *
@@ -119,18 +428,15 @@ class TimeoutQueue : public Queue
      */
     Status front(T *&out) const
     {
-        TMutexTrait::lock(mutex_);
+        Guard guard{*this};
 
         if (empty_impl())
         {
-            TMutexTrait::unlock(mutex_);
             return Status::Empty;
         }
 
         out = data_[head_].data;
 
-        TMutexTrait::unlock(mutex_);
-
         return Status::Ok;
     }
 
@@ -145,25 +451,65 @@ class TimeoutQueue : public Queue
      */
     Status pop(T *&out, long timeout_us = 0)
     {
-
-        // Wait for an element to be available (this handles the mutex locking internally)
-        auto pred = [this] { return !empty_impl(); };
-        bool const ok = TSemaphoreTrait::wait(semaphore_, mutex_, pred, timeout_us);
-        if (!ok)
+        auto const start = begin_wait(timeout_us);
+        Guard guard{*this};
+        if (!wait_not_empty(start, timeout_us))
         {
+            guard.unlock();
+            stats_.on_reject(Status::Empty);
             return Status::Empty;
         }
 
         // Get the front element and remove it
-        out = data_[head_].data;
-        unlink(data_[head_]);
-        size_--;
+        out = pop_impl();
 
-        TMutexTrait::unlock(mutex_);
+        auto const wakeup = settle(0, 1);
+        guard.unlock();
+
+        notify(wakeup);
 
         return Status::Ok;
     }
 
+    /**
+     * @brief Removes up to `out.size()` elements in FIFO order under a single lock.
+     *
+     * Waits like `pop()` until at least one element is available, then drains as many as fit into `out`.
+     *
+     * @param[out] out Receives pointers to the popped elements.
+     * @param timeout_us Time to wait for the first element: 0 returns immediately, a negative value waits forever.
+     * @return Number of elements popped; 0 if the queue stayed empty.
+     */
+    std::size_t pop_n(std::span<T *> out, long timeout_us = 0)
+    {
+        if (out.empty())
+        {
+            return 0;
+        }
+
+        auto const start = begin_wait(timeout_us);
+        Guard guard{*this};
+        if (!wait_not_empty(start, timeout_us))
+        {
+            guard.unlock();
+            stats_.on_reject(Status::Empty);
+            return 0;
+        }
+
+        std::size_t n = 0;
+        while (n < out.size() && !empty_impl())
+        {
+            out[n++] = pop_impl();
+        }
+
+        auto const wakeup = settle(0, n);
+        guard.unlock();
+
+        notify(wakeup);
+
+        return n;
+    }
+
     /**
      * @brief Removes the specified container from the queue.
      *
@@ -177,56 +523,723 @@ class TimeoutQueue : public Queue
      */
     Status remove(T &c)
     {
-        TMutexTrait::lock(mutex_);
+        Guard guard{*this};
 
         if (empty_impl())
         {
-            TMutexTrait::unlock(mutex_);
+            guard.unlock();
+            stats_.on_reject(Status::Empty);
             return Status::Empty;
         }
 
-        auto const id = c.GetId();
+        auto const id = TKey::key(c);
         if (!IdValid(id))
         {
-            TMutexTrait::unlock(mutex_);
             return Status::InvalidId;
         }
         auto &node = data_[id];
-        if (!node)
+        if (!occupied(node))
         {
-            TMutexTrait::unlock(mutex_);
             return Status::NotFound;
         }
         unlink(node);
-        size_--;
+        set_size(size_impl() - 1);
+        stats_.on_remove(1);
 
-        TMutexTrait::unlock(mutex_);
+        auto const wakeup = settle(0, 1);
+        guard.unlock();
+
+        notify(wakeup);
 
         return Status::Ok;
     }
 
+    /**
+     * @brief Removes all elements in O(1) under a single lock.
+     *
+     * Only the list header is reset; the nodes are invalidated by advancing the epoch instead of being walked, and
+     * pending deadlines are dropped the same way. Once every 65535 calls the epoch wraps and the node table is reset
+     * in full.
+     */
+    void clear()
+    {
+        Guard guard{*this};
+        auto const n = size_impl();
+        stats_.on_remove(n);
+        head_ = kNil;
+        tail_ = kNil;
+        set_size(0);
+        if (++epoch_ == 0)
+        {
+            data_.fill(Node{});
+            epoch_ = 1;
+        }
+        if constexpr (kHasTimer)
+        {
+            timer_.clear();
+        }
+        auto const wakeup = settle(0, n);
+        guard.unlock();
+
+        notify(wakeup);
+    }
+
+    /**
+     * @brief Calls `visitor(T &)` for every queued element in FIFO order under a single lock.
+     *
+     * The visitor runs while the queue is locked and must not call back into the queue.
+     */
+    template <typename Visitor> void for_each(Visitor &&visitor) const
+    {
+        Guard guard{*this};
+        for (auto id = head_; id != kNil; id = data_[id].next)
+        {
+            visitor(*data_[id].data);
+        }
+    }
+
+    /**
+     * @brief Empties the queue under a single lock, calling `visitor(T &)` for every element in FIFO order.
+     *
+     * The nodes are reset as they are visited instead of being unlinked one by one, and any deadlines are cancelled.
+     * The visitor runs while the queue is locked and must not call back into the queue.
+     *
+     * @return Number of elements removed.
+     */
+    template <typename Visitor> std::size_t drain(Visitor &&visitor)
+    {
+        Guard guard{*this};
+        auto const n = size_impl();
+        stats_.on_remove(n);
+        auto id = head_;
+        head_ = kNil;
+        tail_ = kNil;
+        set_size(0);
+        while (id != kNil)
+        {
+            auto &node = data_[id];
+            auto const next = node.next;
+            auto *const c = node.data;
+            if constexpr (kHasTimer)
+            {
+                timer_.cancel(id);
+            }
+            node.prev = kNil;
+            node.next = kNil;
+            node.data = nullptr;
+            visitor(*c);
+            id = next;
+        }
+        auto const wakeup = settle(0, n);
+        guard.unlock();
+
+        notify(wakeup);
+
+        return n;
+    }
+
+    /**
+     * @brief Removes every element for which `pred(T const &)` returns true, in one pass under a single lock.
+     *
+     * The remaining elements keep their order. The predicate runs while the queue is locked and must not call back
+     * into the queue.
+     *
+     * @return Number of elements removed.
+     */
+    template <typename Predicate> std::size_t remove_if(Predicate &&pred)
+    {
+        std::size_t n = 0;
+
+        Guard guard{*this};
+        auto id = head_;
+        while (id != kNil)
+        {
+            auto &node = data_[id];
+            auto const next = node.next;
+            if (pred(static_cast<T const &>(*node.data)))
+            {
+                unlink(node);
+                ++n;
+            }
+            id = next;
+        }
+        set_size(size_impl() - n);
+        stats_.on_remove(n);
+        auto const wakeup = settle(0, n);
+        guard.unlock();
+
+        notify(wakeup);
+
+        return n;
+    }
+
+    /**
+     * @brief Pops from a coroutine: `Status s = co_await q.async_pop(out);`
+     *
+     * Takes the front element right away if there is one. Otherwise the coroutine is suspended until an element is
+     * pushed, which is then handed to it directly: the pushing thread resumes the coroutine after releasing the lock,
+     * so no thread is parked on the queue. Suspended pops are served in FIFO order and before threads blocked in
+     * `pop()`.
+     *
+     * @param[out] out Reference to a pointer that will be set to the popped element. Must outlive the `co_await`.
+     * @return Awaitable that yields Status::Ok; without a deadline it never yields anything else.
+     */
+    PopAwaiter async_pop(T *&out)
+    {
+        return PopAwaiter{*this, out, std::numeric_limits<uint64_t>::max()};
+    }
+
+    /**
+     * @brief Pops from a coroutine, giving up at `deadline`.
+     *
+     * The queue has no clock of its own: a suspended pop yields Status::Timeout once the event loop calls
+     * `expire_waiters(now)` with `now` at or past `deadline`.
+     */
+    PopAwaiter async_pop(T *&out, Deadline deadline)
+    {
+        return PopAwaiter{*this, out, deadline.ticks};
+    }
+
+    /**
+     * @brief Pushes from a coroutine: `Status s = co_await q.async_push(c);`
+     *
+     * Pushes right away if the queue has space. Otherwise the coroutine is suspended until an element leaves the
+     * queue; the removing thread then pushes `c` on its behalf and resumes the coroutine with the result, which, as
+     * for `push(T &, long)`, may be Status::Duplicate.
+     */
+    PushAwaiter async_push(T &c)
+    {
+        return PushAwaiter{*this, c, std::numeric_limits<uint64_t>::max()};
+    }
+
+    /**
+     * @brief Pushes from a coroutine, giving up with Status::Timeout at `deadline`; see `async_pop(T *&, Deadline)`.
+     */
+    PushAwaiter async_push(T &c, Deadline deadline)
+    {
+        return PushAwaiter{*this, c, deadline.ticks};
+    }
+
+    /**
+     * @brief Resumes every suspended `async_pop`/`async_push` whose deadline is at or before `now` with
+     * Status::Timeout.
+     *
+     * Walks the waiter lists under the lock and resumes the coroutines after releasing it, in the calling thread.
+     *
+     * @return Number of timed-out waiters.
+     */
+    std::size_t expire_waiters(uint64_t now)
+    {
+        Wakeup wakeup;
+        std::size_t n = 0;
+
+        Guard guard{*this};
+        for (auto *list : {&pop_waiters_, &push_waiters_})
+        {
+            auto *w = list->head;
+            while (w != nullptr)
+            {
+                auto *const next = w->next;
+                if (w->deadline <= now)
+                {
+                    detach(*w);
+                    w->status = Status::Timeout;
+                    stats_.on_reject(list == &pop_waiters_ ? Status::Empty : Status::Full);
+                    wakeup.ready(*w);
+                    ++n;
+                }
+                w = next;
+            }
+        }
+        guard.unlock();
+
+        notify(wakeup);
+
+        return n;
+    }
+
+    /**
+     * @brief Sets the spin phase of blocking pops.
+     *
+     * Before a pop with a non-zero timeout waits on the semaphore, it polls the queue size without taking the lock
+     * for up to `spin_count` rounds, each `cpu_relax()`-ing twice as long as the previous one (capped at
+     * `kMaxBackoff` pauses). This trades CPU time for hand-off latency when producers refill the queue within
+     * microseconds; the spin time is not deducted from the timeout.
+     *
+     * @param spin_count Number of backoff rounds, 0 to block immediately.
+     */
+    void set_spin_count(uint32_t spin_count)
+    {
+        spin_count_.store(spin_count, std::memory_order_relaxed);
+    }
+
+    uint32_t spin_count() const
+    {
+        return spin_count_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Registers the listener that is told about newly pushed elements, or removes it with nullptr.
+     *
+     * A queue has at most one listener, which must stay alive until it has been removed and no push that may still
+     * call it is in flight. Without a listener a push pays one extra atomic load.
+     */
+    void set_push_listener(PushListener const *listener)
+    {
+        listener_.store(listener, std::memory_order_release);
+    }
+
+    /**
+     * @brief Returns the number of queued elements without taking the lock.
+     *
+     * The value is a relaxed read of a counter that is updated under the lock, so it is never torn but may already be
+     * stale when it is returned. Use it for monitoring and load-shedding heuristics, not to predict the result of a
+     * following `push()` or `pop()`.
+     */
     std::size_t size() const
     {
-        TMutexTrait::lock(mutex_);
-        auto const size{size_impl()};
-        TMutexTrait::unlock(mutex_);
-        return size;
+        return size_impl();
     }
 
+    /**
+     * @brief Lock-free, possibly stale check for a full queue; see `size()`.
+     */
     bool full() const
     {
-        return size() == capacity_;
+        return full_impl();
     }
 
+    /**
+     * @brief Lock-free, possibly stale check for an empty queue; see `size()`.
+     */
     bool empty() const
     {
-        return size() == 0;
+        return empty_impl();
+    }
+
+    /**
+     * @brief Returns the statistics policy without taking the lock, e.g. for `stats().snapshot()` with `QueueStats`.
+     */
+    TStats const &stats() const
+    {
+        return stats_;
     }
 
   private:
+    // Placeholder for the lock timestamp when the statistics policy does not time anything
+    struct Untimed
+    {
+    };
+
+    static uint64_t now_ns()
+    {
+        auto const t = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t).count());
+    }
+
+    // Every critical section goes through these two so that a timing statistics policy sees each lock hold.
+    void lock() const
+    {
+        TMutexTrait::lock(mutex_);
+        locked();
+    }
+
+    void locked() const
+    {
+        if constexpr (TStats::kTimed)
+        {
+            locked_at_ = now_ns();
+        }
+    }
+
+    void unlock() const
+    {
+        if constexpr (TStats::kTimed)
+        {
+            stats_.on_lock_hold(now_ns() - locked_at_);
+        }
+        TMutexTrait::unlock(mutex_);
+    }
+
+    // Holds the lock for a scope. `unlock()` releases it early, before the wake-ups are sent; either way exactly once.
+    class Guard
+    {
+      public:
+        explicit Guard(TimeoutQueue const &queue) : queue_{queue}
+        {
+            queue_.lock();
+        }
+
+        ~Guard()
+        {
+            if (owned_)
+            {
+                queue_.unlock();
+            }
+        }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+        void unlock()
+        {
+            queue_.unlock();
+            owned_ = false;
+        }
+
+      private:
+        TimeoutQueue const &queue_;
+        bool owned_{true};
+    };
+
+    /**
+     * @brief Waits on `semaphore` until `condition()` holds; called with the lock held and returns with it held.
+     *
+     * A blocking wait is registered in `waiters` for as long as it lasts, so the other side only signals the semaphore
+     * when a thread can actually be sleeping on it. The trait releases the lock only while the thread sleeps.
+     *
+     * @return true if the condition holds, false on timeout.
+     */
+    template <typename Condition>
+    bool wait_until(TSemaphore &semaphore, std::size_t &waiters, Condition condition, long timeout_us)
+    {
+        if (condition())
+        {
+            return true;
+        }
+        if (timeout_us == 0)
+        {
+            return false;
+        }
+
+        waiters++;
+        if constexpr (TStats::kTimed)
+        {
+            stats_.on_lock_hold(now_ns() - locked_at_);
+        }
+        auto const ok = TSemaphoreTrait::wait(semaphore, mutex_, condition, timeout_us);
+        locked();
+        waiters--;
+        return ok;
+    }
+
+    // Consumer side, before taking the lock: spins (see set_spin_count()) and returns the start of the wait.
+    uint64_t begin_wait(long timeout_us) const
+    {
+        if (timeout_us == 0)
+        {
+            return 0;
+        }
+        uint64_t start = 0;
+        if constexpr (TStats::kTimed)
+        {
+            start = now_ns();
+        }
+        spin_until_not_empty();
+        return start;
+    }
+
+    // Consumer side, with the lock held: waits on semaphore_. Blocking waits, including the spin phase, are reported
+    // to the statistics policy.
+    bool wait_not_empty(uint64_t start, long timeout_us)
+    {
+        auto const ok = wait_until(semaphore_, waiters_, [this] { return !empty_impl(); }, timeout_us);
+        if constexpr (TStats::kTimed)
+        {
+            if (timeout_us != 0)
+            {
+                stats_.on_wait(now_ns() - start);
+            }
+        }
+        return ok;
+    }
+
+    // Polls the size mirror with exponential backoff; a non-empty queue is re-checked under the lock afterwards.
+    void spin_until_not_empty() const
+    {
+        auto const rounds = spin_count();
+        std::size_t backoff = 1;
+        for (uint32_t i = 0; i < rounds && empty_impl(); ++i)
+        {
+            for (std::size_t j = 0; j < backoff; ++j)
+            {
+                cpu_relax();
+            }
+            backoff = std::min(backoff * 2, kMaxBackoff);
+        }
+    }
+
+    // Everything an operation has to wake once it released the lock.
+    struct Wakeup
+    {
+        Waiter *head{nullptr};
+        Waiter *tail{nullptr};
+        std::size_t consumers{0};
+        std::size_t producers{0};
+        // New elements left in the queue, reported to the push listener
+        std::size_t added{0};
+
+        // Chains an unlinked waiter for resumption, keeping FIFO order
+        void ready(Waiter &w)
+        {
+            w.next = nullptr;
+            if (tail != nullptr)
+            {
+                tail->next = &w;
+            }
+            else
+            {
+                head = &w;
+            }
+            tail = &w;
+        }
+    };
+
+    /**
+     * @brief Serves the coroutine waiters after `pushed` elements were added and `removed` were taken, under the lock.
+     *
+     * Suspended pops take elements while there are any and suspended pushes fill free slots, until neither can make
+     * progress; each pop hand-off frees a slot and each admitted push adds an element. Whatever is left over is
+     * offered to the threads blocked on the semaphores, clamped to the number of registered waiters.
+     */
+    Wakeup settle(std::size_t pushed, std::size_t removed)
+    {
+        Wakeup wakeup;
+        std::size_t handed = 0;
+        std::size_t admitted = 0;
+
+        bool progress = true;
+        while (progress)
+        {
+            progress = false;
+            while (pop_waiters_.head != nullptr && !empty_impl())
+            {
+                auto &w = *pop_waiters_.head;
+                detach(w);
+                w.element = pop_impl();
+                w.status = Status::Ok;
+                wakeup.ready(w);
+                ++handed;
+                progress = true;
+            }
+            while (push_waiters_.head != nullptr && !full_impl())
+            {
+                auto &w = *push_waiters_.head;
+                detach(w);
+                w.status = push_impl(*w.element);
+                if (w.status == Status::Ok)
+                {
+                    ++admitted;
+                    progress = true;
+                }
+                wakeup.ready(w);
+            }
+        }
+
+        auto const added = pushed + admitted;
+        auto const taken = removed + handed;
+        wakeup.added = added > handed ? added - handed : 0;
+        wakeup.consumers = std::min(wakeup.added, waiters_);
+        wakeup.producers = std::min(taken > admitted ? taken - admitted : 0, space_waiters_);
+        return wakeup;
+    }
+
+    /**
+     * @brief Signals the blocked threads and the push listener, and resumes the coroutines collected by `settle()` or
+     * `expire_waiters()`.
+     *
+     * Called without the lock held. A resumed coroutine may destroy its waiter, so the chain is read ahead.
+     */
+    void notify(Wakeup const &wakeup)
+    {
+        wake(semaphore_, wakeup.consumers);
+        wake(space_semaphore_, wakeup.producers);
+        if (wakeup.added > 0)
+        {
+            if (auto const *listener = listener_.load(std::memory_order_acquire))
+            {
+                listener->on_push(listener->context, wakeup.added);
+            }
+        }
+        auto *w = wakeup.head;
+        while (w != nullptr)
+        {
+            auto *const next = w->next;
+            auto const handle = w->handle;
+            handle.resume();
+            w = next;
+        }
+    }
+
+    // Takes the element for a suspending pop, or queues its waiter; false resumes the coroutine right away.
+    bool suspend_pop(Waiter &w, std::coroutine_handle<> handle)
+    {
+        Guard guard{*this};
+        if (!empty_impl())
+        {
+            w.element = pop_impl();
+            w.status = Status::Ok;
+            auto const wakeup = settle(0, 1);
+            guard.unlock();
+
+            notify(wakeup);
+            return false;
+        }
+        w.handle = handle;
+        attach(pop_waiters_, w);
+        return true;
+    }
+
+    // Pushes for a suspending push, or queues its waiter while the queue is full.
+    bool suspend_push(Waiter &w, std::coroutine_handle<> handle)
+    {
+        Guard guard{*this};
+        if (!full_impl())
+        {
+            w.status = push_impl(*w.element);
+            auto const wakeup = settle(w.status == Status::Ok ? 1 : 0, 0);
+            guard.unlock();
+
+            notify(wakeup);
+            return false;
+        }
+        w.handle = handle;
+        attach(push_waiters_, w);
+        return true;
+    }
+
+    // Called when an awaiter is destroyed; it is only still linked if its coroutine was destroyed while suspended.
+    void cancel(Waiter &w)
+    {
+        // Lock-free fast path for awaiters that never suspended or were resumed: `list` is cleared under the lock by
+        // settle() or expire_waiters(), which then resume the coroutine after unlocking, so the awaiter is destroyed
+        // after that write. Only destroying a suspended coroutine while another thread resumes it could race, and
+        // that is undefined anyway.
+        if (w.list == nullptr)
+        {
+            return;
+        }
+        Guard guard{*this};
+        if (w.list != nullptr)
+        {
+            detach(w);
+        }
+    }
+
+    void attach(WaiterList &list, Waiter &w)
+    {
+        w.prev = list.tail;
+        w.next = nullptr;
+        if (list.tail != nullptr)
+        {
+            list.tail->next = &w;
+        }
+        else
+        {
+            list.head = &w;
+        }
+        list.tail = &w;
+        w.list = &list;
+    }
+
+    void detach(Waiter &w)
+    {
+        auto &list = *w.list;
+        if (w.prev != nullptr)
+        {
+            w.prev->next = w.next;
+        }
+        else
+        {
+            list.head = w.next;
+        }
+        if (w.next != nullptr)
+        {
+            w.next->prev = w.prev;
+        }
+        else
+        {
+            list.tail = w.prev;
+        }
+        w.prev = nullptr;
+        w.next = nullptr;
+        w.list = nullptr;
+    }
+
+    /**
+     * @brief Wakes `k` threads blocked on `semaphore`; `k` is already clamped to the waiters sampled under the lock.
+     *
+     * Called without the lock held.
+     */
+    void wake(TSemaphore &semaphore, std::size_t k)
+    {
+        if constexpr (kHasNotifyAll)
+        {
+            if (k > 1)
+            {
+                TSemaphoreTrait::notify_all(semaphore);
+                return;
+            }
+        }
+        for (std::size_t i = 0; i < k; ++i)
+        {
+            TSemaphoreTrait::notify(semaphore);
+        }
+    }
+
+    Status push_impl(T &c)
+    {
+        if (full_impl())
+        {
+            stats_.on_reject(Status::Full);
+            return Status::Full;
+        }
+
+        auto const id = TKey::key(c);
+
+        if (!IdValid(id))
+        {
+            return Status::InvalidId;
+        }
+
+        auto &node = data_[id];
+
+        if (occupied(node))
+        {
+            stats_.on_reject(Status::Duplicate);
+            return Status::Duplicate;
+        }
+
+        // Fill node with data
+        node.data = &c;
+        node.epoch = epoch_;
+
+        // Link the next and prev
+        link(node);
+        set_size(size_impl() + 1);
+        stats_.on_push(1, size_impl());
+
+        return Status::Ok;
+    }
+
+    T *pop_impl()
+    {
+        auto *const out = data_[head_].data;
+        unlink(data_[head_]);
+        set_size(size_impl() - 1);
+        stats_.on_pop(1);
+        return out;
+    }
+
     std::size_t size_impl() const
     {
-        return size_;
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    // size_ is only written under the lock; it is atomic so the spin phase and the observers can read it without it.
+    void set_size(std::size_t size)
+    {
+        size_.store(size, std::memory_order_relaxed);
     }
     bool full_impl() const
     {
@@ -238,27 +1251,31 @@ class TimeoutQueue : public Queue
         return size_impl() == 0;
     }
 
-    static constexpr uint16_t kNil{std::numeric_limits<uint16_t>::max()};
+    using Index = LinkIndex<Capacity>;
+    static constexpr Index kNil{std::numeric_limits<Index>::max()};
 
     struct Node
     {
-        uint16_t prev{kNil};
-        uint16_t next{kNil};
+        Index prev{kNil};
+        Index next{kNil};
+        Epoch epoch{0};
         T *data{nullptr};
-        constexpr operator bool() const
-        {
-            return data != nullptr;
-        }
     };
 
-    bool IdValid(uint16_t id) const
+    // Nodes left over from before the last clear() carry an older epoch and count as free
+    bool occupied(Node const &n) const
+    {
+        return n.epoch == epoch_ && n.data != nullptr;
+    }
+
+    bool IdValid(std::size_t id) const
     {
         return id < capacity_;
     }
 
     void link(Node &n)
     {
-        auto const id = n.data->GetId();
+        auto const id = static_cast<Index>(TKey::key(*n.data));
         n.prev = tail_;
         n.next = kNil;
         if (tail_ != kNil)
@@ -274,7 +1291,10 @@ class TimeoutQueue : public Queue
 
     void unlink(Node &n)
     {
-        // auto const id = n.data->GetId();
+        if constexpr (kHasTimer)
+        {
+            timer_.cancel(static_cast<std::size_t>(&n - data_.data()));
+        }
         if (n.prev != kNil)
         {
             data_[n.prev].next = n.next;
@@ -296,16 +1316,49 @@ class TimeoutQueue : public Queue
         n.data = nullptr;
     }
 
-    std::size_t size_{0};
-    uint16_t capacity_;
-    uint16_t head_ = kNil;
-    uint16_t tail_ = kNil;
-    std::array<Node, kNil> data_;
+    // Each independently contended group gets its own cache line: lockers spinning on the mutex, lock-free
+    // observers reading size_, and notifiers touching the semaphore no longer invalidate each other's lines.
+
+    // Read-mostly configuration
+    std::size_t capacity_;
+    std::atomic<uint32_t> spin_count_;
+    std::atomic<PushListener const *> listener_{nullptr};
 
-    mutable TMutex mutex_;
-    TSemaphore semaphore_;
+    // List header, written by every push and pop under the lock
+    alignas(kCacheLineSize) std::atomic<std::size_t> size_{0};
+    // Consumers blocked in semaphore_ and producers blocked in space_semaphore_, guarded by mutex_
+    std::size_t waiters_{0};
+    std::size_t space_waiters_{0};
+    Index head_ = kNil;
+    Index tail_ = kNil;
+    Epoch epoch_{1};
+    // Suspended coroutines, guarded by mutex_
+    WaiterList pop_waiters_;
+    WaiterList push_waiters_;
+    // Start of the current lock hold, only present with a timing statistics policy
+    [[no_unique_address]] mutable std::conditional_t<TStats::kTimed, uint64_t, Untimed> locked_at_{};
+
+    alignas(kCacheLineSize) mutable TMutex mutex_;
+
+    alignas(kCacheLineSize) TSemaphore semaphore_;
+
+    alignas(kCacheLineSize) TSemaphore space_semaphore_;
+
+    alignas(kCacheLineSize) std::array<Node, Capacity> data_;
+    [[no_unique_address]] TTimer timer_;
+    [[no_unique_address]] mutable TStats stats_;
 };
 
+/**
+ * @brief TimeoutQueue whose mutex and semaphore types and traits come from a lock policy, e.g. `SpinLockPolicy` from
+ * Traits.hpp: `PolicyTimeoutQueue<Job, SpinLockPolicy, 1024>`.
+ */
+template <typename T, typename TPolicy, std::size_t Capacity = Queue::kMaxCapacity, typename TTimer = NoTimer,
+          typename TKey = GetIdKey, typename TStats = NoStats>
+using PolicyTimeoutQueue =
+    TimeoutQueue<T, typename TPolicy::Mutex, typename TPolicy::Semaphore, typename TPolicy::MutexTrait,
+                 typename TPolicy::SemaphoreTrait, Capacity, TTimer, TKey, TStats>;
+
 } // namespace fcp
 
 #endif
\ No newline at end of file
@@ -0,0 +1,368 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include "IndexPolicy.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace fcp
+{
+
+/**
+ * @brief Absolute expiry time of a queued element, in caller-defined ticks (e.g. microseconds or milliseconds).
+ *
+ * A distinct type so `push(c, Deadline{t})` cannot be confused with a relative timeout.
+ */
+struct Deadline
+{
+    uint64_t ticks;
+};
+
+/**
+ * @brief Timer policy for queues without per-element deadlines.
+ */
+struct NoTimer
+{
+    static constexpr std::size_t kCapacity{std::numeric_limits<std::size_t>::max()};
+};
+
+/**
+ * @brief A hierarchical timing wheel for ID-indexed timers.
+ *
+ * The TimerWheel class tracks at most one deadline per ID in `0 .. Capacity - 1`:
+ * - O(1) schedule and cancel: Each ID owns one node that is linked into a doubly linked slot list.
+ * - Four levels of 64 slots cover 2^24 ticks ahead of the current time; later deadlines are parked in the last slot
+ *   of the top level and re-filed when it is cascaded.
+ * - `advance(now)` moves every timer with a deadline at or before `now` onto a due list, from which `pop_due()`
+ *   hands them out. Timers that become due in the same `advance()` call may be handed out in any order.
+ * - No dynamic memory allocation: All storage is preallocated based on the specified capacity.
+ *
+ * Each level keeps a bitmap of its non-empty slots, so advancing jumps straight to the next tick at which a slot has
+ * to be expired or cascaded: the cost is O(1) per occupied slot passed plus O(1) per cascaded timer, not per elapsed
+ * tick. A jump of more than the wheel span re-files all pending timers once instead.
+ *
+ * @tparam Capacity Number of IDs that can carry a timer.
+ */
+template <std::size_t Capacity> class TimerWheel
+{
+  public:
+    static constexpr std::size_t kCapacity{Capacity};
+
+    constexpr TimerWheel()
+    {
+        heads_.fill(kNil);
+    }
+
+    /**
+     * @brief Schedules or reschedules the timer of `id` to expire at `deadline`.
+     */
+    constexpr void schedule(std::size_t id, uint64_t deadline)
+    {
+        cancel(id);
+        nodes_[id].epoch = epoch_;
+        nodes_[id].deadline = deadline;
+        file(id);
+        pending_++;
+    }
+
+    /**
+     * @brief Cancels the timer of `id`, whether it is still pending or already due.
+     *
+     * @return true if a timer was cancelled.
+     */
+    constexpr bool cancel(std::size_t id)
+    {
+        if (!scheduled(id))
+        {
+            return false;
+        }
+        detach(id);
+        pending_--;
+        return true;
+    }
+
+    /**
+     * @brief Returns true if `id` has a pending or due timer.
+     */
+    constexpr bool scheduled(std::size_t id) const
+    {
+        return nodes_[id].epoch == epoch_ && nodes_[id].list != kNone;
+    }
+
+    /**
+     * @brief Cancels every timer in time independent of the number of timers.
+     *
+     * The slot lists are emptied and the nodes are invalidated by advancing the epoch. The current time is kept.
+     */
+    constexpr void clear()
+    {
+        heads_.fill(kNil);
+        occupied_.fill(0);
+        due_tail_ = kNil;
+        pending_ = 0;
+        due_count_ = 0;
+        if (++epoch_ == 0)
+        {
+            nodes_.fill(Node{});
+            epoch_ = 1;
+        }
+    }
+
+    /**
+     * @brief Moves all timers with a deadline at or before `now` onto the due list.
+     */
+    constexpr void advance(uint64_t now)
+    {
+        if (now < current_)
+        {
+            return;
+        }
+        if (pending_ == due_count_)
+        {
+            // Nothing left in the wheel, skip the idle ticks.
+            current_ = now + 1;
+            return;
+        }
+        if (now - current_ >= kSpan)
+        {
+            current_ = now + 1;
+            for (std::size_t list = 0; list < kDue; ++list)
+            {
+                refile(list);
+            }
+            return;
+        }
+        // Only ticks that expire a level-0 slot or cascade a non-empty upper slot do any work; the rest are skipped
+        for (auto tick = next_event(); tick <= now; tick = next_event())
+        {
+            current_ = tick;
+            auto const index = current_ & kSlotMask;
+            if (index == 0)
+            {
+                cascade();
+            }
+            auto const list = index;
+            while (heads_[list] != kNil)
+            {
+                auto const id = heads_[list];
+                detach(id);
+                append_due(id);
+            }
+            current_++;
+        }
+        current_ = now + 1;
+    }
+
+    /**
+     * @brief Takes the oldest timer from the due list.
+     *
+     * @param[out] id Receives the ID of the expired timer.
+     * @return false if no timer is due.
+     */
+    constexpr bool pop_due(std::size_t &id)
+    {
+        if (heads_[kDue] == kNil)
+        {
+            return false;
+        }
+        id = heads_[kDue];
+        cancel(id);
+        return true;
+    }
+
+  private:
+    using Index = LinkIndex<Capacity>;
+    static constexpr Index kNil{std::numeric_limits<Index>::max()};
+
+    static constexpr std::size_t kSlotBits{6};
+    static constexpr std::size_t kSlots{std::size_t{1} << kSlotBits};
+    static constexpr std::size_t kSlotMask{kSlots - 1};
+    static constexpr std::size_t kLevels{4};
+    static constexpr uint64_t kSpan{uint64_t{1} << (kSlotBits * kLevels)};
+
+    // Lists 0 .. kLevels * kSlots - 1 are the wheel slots, list kDue holds expired timers.
+    static constexpr uint16_t kDue{kLevels * kSlots};
+    static constexpr uint16_t kNone{std::numeric_limits<uint16_t>::max()};
+
+    struct Node
+    {
+        Index prev{kNil};
+        Index next{kNil};
+        uint16_t list{kNone};
+        Epoch epoch{0};
+        uint64_t deadline{0};
+    };
+
+    /**
+     * @brief Returns the first tick at or after `current_` at which an occupied slot is expired or cascaded.
+     *
+     * Slot `k` of level `L` is processed at the first multiple of `kSlots^L` whose level-`L` digit is `k`, so for each
+     * level the next occupied slot is either later in the current rotation or, failing that, in the next one.
+     */
+    constexpr uint64_t next_event() const
+    {
+        auto next = std::numeric_limits<uint64_t>::max();
+        for (std::size_t level = 0; level < kLevels; ++level)
+        {
+            auto const bits = occupied_[level];
+            if (bits == 0)
+            {
+                continue;
+            }
+            auto const shift = kSlotBits * level;
+            auto const base = current_ >> shift;
+            auto const index = base & kSlotMask;
+            // Mid-slot, the current upper-level slot was already cascaded when the slot began
+            auto const aligned = (current_ & ((uint64_t{1} << shift) - 1)) == 0;
+            auto const first = aligned ? index : index + 1;
+            auto const ahead = first < kSlots ? bits >> first << first : 0;
+            auto const rotation = base & ~uint64_t{kSlotMask};
+            auto const slot = ahead != 0 ? rotation + std::countr_zero(ahead)
+                                         : rotation + kSlots + std::countr_zero(bits);
+            next = std::min(next, slot << shift);
+        }
+        return next;
+    }
+
+    constexpr void mark(std::size_t list)
+    {
+        occupied_[list / kSlots] |= uint64_t{1} << (list % kSlots);
+    }
+
+    constexpr void unmark(std::size_t list)
+    {
+        occupied_[list / kSlots] &= ~(uint64_t{1} << (list % kSlots));
+    }
+
+    // Picks the slot for a deadline relative to the next tick to be processed.
+    constexpr void file(std::size_t id)
+    {
+        auto const deadline = nodes_[id].deadline;
+        if (deadline < current_)
+        {
+            append_due(id);
+            return;
+        }
+        auto const delta = deadline - current_;
+        std::size_t level = 0;
+        while (level + 1 < kLevels && delta >= (uint64_t{1} << (kSlotBits * (level + 1))))
+        {
+            level++;
+        }
+        auto const when = delta < kSpan ? deadline : current_ + kSpan - 1;
+        auto const slot = (when >> (kSlotBits * level)) & kSlotMask;
+        push_front(id, static_cast<uint16_t>(level * kSlots + slot));
+    }
+
+    constexpr void cascade()
+    {
+        for (std::size_t level = 1; level < kLevels; ++level)
+        {
+            auto const index = (current_ >> (kSlotBits * level)) & kSlotMask;
+            refile(level * kSlots + index);
+            if (index != 0)
+            {
+                break;
+            }
+        }
+    }
+
+    // Re-files every timer of a slot list against the current time.
+    constexpr void refile(std::size_t list)
+    {
+        auto id = heads_[list];
+        heads_[list] = kNil;
+        unmark(list);
+        while (id != kNil)
+        {
+            auto const next = nodes_[id].next;
+            nodes_[id].list = kNone;
+            nodes_[id].prev = kNil;
+            nodes_[id].next = kNil;
+            file(id);
+            id = next;
+        }
+    }
+
+    constexpr void push_front(std::size_t id, uint16_t list)
+    {
+        auto &n = nodes_[id];
+        n.list = list;
+        n.prev = kNil;
+        n.next = heads_[list];
+        if (n.next != kNil)
+        {
+            nodes_[n.next].prev = static_cast<Index>(id);
+        }
+        heads_[list] = static_cast<Index>(id);
+        mark(list);
+    }
+
+    constexpr void append_due(std::size_t id)
+    {
+        auto &n = nodes_[id];
+        n.list = kDue;
+        n.prev = due_tail_;
+        n.next = kNil;
+        if (due_tail_ != kNil)
+        {
+            nodes_[due_tail_].next = static_cast<Index>(id);
+        }
+        else
+        {
+            heads_[kDue] = static_cast<Index>(id);
+        }
+        due_tail_ = static_cast<Index>(id);
+        due_count_++;
+    }
+
+    constexpr void detach(std::size_t id)
+    {
+        auto &n = nodes_[id];
+        if (n.prev != kNil)
+        {
+            nodes_[n.prev].next = n.next;
+        }
+        else
+        {
+            heads_[n.list] = n.next;
+        }
+        if (n.next != kNil)
+        {
+            nodes_[n.next].prev = n.prev;
+        }
+        else if (n.list == kDue)
+        {
+            due_tail_ = n.prev;
+        }
+        if (n.list == kDue)
+        {
+            due_count_--;
+        }
+        else if (heads_[n.list] == kNil)
+        {
+            unmark(n.list);
+        }
+        n.prev = kNil;
+        n.next = kNil;
+        n.list = kNone;
+    }
+
+    uint64_t current_{0};
+    std::size_t pending_{0};
+    std::size_t due_count_{0};
+    Index due_tail_{kNil};
+    Epoch epoch_{1};
+    std::array<Index, kDue + 1> heads_{};
+    // Bit `k` of entry `L` is set while slot `k` of level `L` is non-empty
+    std::array<uint64_t, kLevels> occupied_{};
+    std::array<Node, Capacity> nodes_{};
+};
+
+} // namespace fcp
+
+#endif // TIMER_WHEEL_HPP
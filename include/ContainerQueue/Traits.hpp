@@ -0,0 +1,424 @@
+#ifndef TRAITS_HPP
+#define TRAITS_HPP
+
+#include "Platform.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace fcp
+{
+
+/**
+ * @brief Mutex trait for any type with `lock()`/`unlock()` members, e.g. `std::mutex`, `SpinLock` or `TicketLock`.
+ */
+template <typename TMutex> struct LockableTrait
+{
+    static void init(TMutex &)
+    {
+    }
+    static void lock(TMutex &m)
+    {
+        m.lock();
+    }
+    static void unlock(TMutex &m)
+    {
+        m.unlock();
+    }
+};
+
+/**
+ * @brief Test-and-test-and-set spinlock with exponential `cpu_relax()` backoff.
+ *
+ * Waiters spin on a plain load, so the lock's cache line stays shared until it is released, and only then try the
+ * exchange. Once the backoff is saturated a waiter also yields its time slice, which keeps a preempted lock holder
+ * from being starved on an oversubscribed machine. Meant for critical sections of a few dozen nanoseconds.
+ */
+class SpinLock
+{
+  public:
+    /// Upper bound on the `cpu_relax()` calls between two looks at the lock.
+    static constexpr std::size_t kMaxBackoff{64};
+
+    void lock() noexcept
+    {
+        std::size_t backoff = 1;
+        while (locked_.exchange(true, std::memory_order_acquire))
+        {
+            while (locked_.load(std::memory_order_relaxed))
+            {
+                relax(backoff);
+            }
+        }
+    }
+
+    bool try_lock() noexcept
+    {
+        return !locked_.load(std::memory_order_relaxed) && !locked_.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock() noexcept
+    {
+        locked_.store(false, std::memory_order_release);
+    }
+
+  private:
+    static void relax(std::size_t &backoff) noexcept
+    {
+        for (std::size_t i = 0; i < backoff; ++i)
+        {
+            cpu_relax();
+        }
+        if (backoff < kMaxBackoff)
+        {
+            backoff *= 2;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    std::atomic<bool> locked_{false};
+};
+
+/**
+ * @brief FIFO ticket spinlock.
+ *
+ * Each waiter draws a ticket and spins until it is served, backing off in proportion to its distance from the head of
+ * the line. Unlike `SpinLock`, the lock is handed out strictly in arrival order, so no thread can be starved; in
+ * exchange a preempted waiter holds up everyone behind it.
+ */
+class TicketLock
+{
+  public:
+    void lock() noexcept
+    {
+        auto const ticket = next_.fetch_add(1, std::memory_order_relaxed);
+        std::size_t rounds = 0;
+        for (auto serving = serving_.load(std::memory_order_acquire); serving != ticket;
+             serving = serving_.load(std::memory_order_acquire))
+        {
+            auto const distance = static_cast<uint32_t>(ticket - serving);
+            for (uint32_t i = 0; i < distance; ++i)
+            {
+                cpu_relax();
+            }
+            if (++rounds % 64 == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void unlock() noexcept
+    {
+        serving_.store(serving_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+  private:
+    std::atomic<uint32_t> next_{0};
+    std::atomic<uint32_t> serving_{0};
+};
+
+/**
+ * @brief Mutex for queues that are only used by one thread.
+ */
+struct NullMutex
+{
+};
+
+/**
+ * @brief Mutex trait for `NullMutex`; every operation is an empty constexpr function, so locking compiles out.
+ */
+struct NullMutexTrait
+{
+    static constexpr void init(NullMutex &)
+    {
+    }
+    static constexpr void lock(NullMutex &)
+    {
+    }
+    static constexpr void unlock(NullMutex &)
+    {
+    }
+};
+
+/**
+ * @brief Semaphore trait for `std::condition_variable` with `std::mutex`.
+ *
+ * Follows the TimeoutQueue contract: `wait` is entered with the mutex held, releases it only while blocked on the
+ * condition variable and returns with it held, whether `pred` was satisfied or the wait timed out.
+ */
+struct StdSemaphoreTrait
+{
+    static void init(std::condition_variable &)
+    {
+    }
+
+    template <typename Predicate>
+    static bool wait(std::condition_variable &cv, std::mutex &mtx, Predicate pred, long timeout_us)
+    {
+        std::unique_lock<std::mutex> lock(mtx, std::adopt_lock);
+        bool ok = true;
+        if (timeout_us < 0)
+        {
+            cv.wait(lock, pred);
+        }
+        else if (timeout_us == 0)
+        {
+            ok = pred();
+        }
+        else
+        {
+            ok = cv.wait_for(lock, std::chrono::microseconds(timeout_us), pred);
+        }
+        // Ownership goes back to the caller, which unlocks exactly once
+        lock.release();
+        return ok;
+    }
+
+    static void notify(std::condition_variable &cv)
+    {
+        cv.notify_one();
+    }
+
+    static void notify_all(std::condition_variable &cv)
+    {
+        cv.notify_all();
+    }
+};
+
+namespace detail
+{
+// Adapts a mutex trait to the Lockable requirements of std::condition_variable_any.
+template <typename TMutex, typename TMutexTrait> struct TraitLock
+{
+    void lock()
+    {
+        TMutexTrait::lock(mutex);
+    }
+    void unlock()
+    {
+        TMutexTrait::unlock(mutex);
+    }
+
+    TMutex &mutex;
+};
+} // namespace detail
+
+/**
+ * @brief Semaphore trait for `std::condition_variable_any`, usable with any mutex that has a mutex trait.
+ *
+ * @tparam TMutexTrait Trait used to release and reacquire the queue mutex around the sleep.
+ */
+template <typename TMutexTrait> struct CondVarSemaphoreTrait
+{
+    static void init(std::condition_variable_any &)
+    {
+    }
+
+    template <typename TMutex, typename Predicate>
+    static bool wait(std::condition_variable_any &cv, TMutex &mtx, Predicate pred, long timeout_us)
+    {
+        detail::TraitLock<TMutex, TMutexTrait> lock{mtx};
+        bool ok = true;
+        if (timeout_us < 0)
+        {
+            cv.wait(lock, pred);
+        }
+        else if (timeout_us == 0)
+        {
+            ok = pred();
+        }
+        else
+        {
+            ok = cv.wait_for(lock, std::chrono::microseconds(timeout_us), pred);
+        }
+        return ok;
+    }
+
+    static void notify(std::condition_variable_any &cv)
+    {
+        cv.notify_one();
+    }
+
+    static void notify_all(std::condition_variable_any &cv)
+    {
+        cv.notify_all();
+    }
+};
+
+/**
+ * @brief Semaphore placeholder for queues whose waits never block.
+ */
+struct NullSemaphore
+{
+};
+
+/**
+ * @brief Semaphore trait that evaluates the predicate once and never sleeps, whatever the timeout.
+ *
+ * Together with `NullMutex` it turns TimeoutQueue into a single-threaded container; with a real mutex it makes every
+ * blocking operation a try-operation.
+ */
+struct NullSemaphoreTrait
+{
+    static constexpr void init(NullSemaphore &)
+    {
+    }
+
+    template <typename TMutex, typename Predicate>
+    static constexpr bool wait(NullSemaphore &, TMutex &, Predicate pred, long)
+    {
+        return pred();
+    }
+
+    static constexpr void notify(NullSemaphore &)
+    {
+    }
+
+    static constexpr void notify_all(NullSemaphore &)
+    {
+    }
+};
+
+#if defined(__linux__)
+/**
+ * @brief Semaphore built directly on a Linux futex word.
+ *
+ * The word is a wake-up sequence number: waiters read it under the queue mutex before sleeping on it, and notifiers
+ * bump it before calling `FUTEX_WAKE`, so a notify that lands between unlocking and sleeping makes `FUTEX_WAIT`
+ * return at once instead of being lost.
+ */
+struct FutexSemaphore
+{
+    std::atomic<uint32_t> sequence{0};
+};
+
+/**
+ * @brief Semaphore trait for `FutexSemaphore`, usable with any mutex that has a mutex trait.
+ *
+ * Uncontended notifies cost one atomic increment and one system call; TimeoutQueue only notifies when a thread is
+ * registered as waiting.
+ *
+ * @tparam TMutexTrait Trait used to release and reacquire the queue mutex around the sleep.
+ */
+template <typename TMutexTrait> struct FutexSemaphoreTrait
+{
+    static void init(FutexSemaphore &)
+    {
+    }
+
+    template <typename TMutex, typename Predicate>
+    static bool wait(FutexSemaphore &sem, TMutex &mtx, Predicate pred, long timeout_us)
+    {
+        using Clock = std::chrono::steady_clock;
+        auto const deadline = Clock::now() + std::chrono::microseconds(std::max(timeout_us, 0L));
+
+        while (!pred())
+        {
+            if (timeout_us == 0)
+            {
+                return false;
+            }
+            auto const seen = sem.sequence.load(std::memory_order_relaxed);
+            TMutexTrait::unlock(mtx);
+
+            if (timeout_us < 0)
+            {
+                futex(sem, FUTEX_WAIT_PRIVATE, seen, nullptr);
+            }
+            else
+            {
+                auto const remaining = deadline - Clock::now();
+                if (remaining <= Clock::duration::zero())
+                {
+                    // Out of time; the predicate gets one last look under the lock
+                    TMutexTrait::lock(mtx);
+                    return pred();
+                }
+                auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+                timespec ts{static_cast<time_t>(ns / 1000000000), static_cast<long>(ns % 1000000000)};
+                futex(sem, FUTEX_WAIT_PRIVATE, seen, &ts);
+            }
+
+            TMutexTrait::lock(mtx);
+        }
+        return true;
+    }
+
+    static void notify(FutexSemaphore &sem)
+    {
+        sem.sequence.fetch_add(1, std::memory_order_release);
+        futex(sem, FUTEX_WAKE_PRIVATE, 1, nullptr);
+    }
+
+    static void notify_all(FutexSemaphore &sem)
+    {
+        sem.sequence.fetch_add(1, std::memory_order_release);
+        futex(sem, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr);
+    }
+
+  private:
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free,
+                  "FutexSemaphore needs a plain 32-bit futex word");
+
+    static void futex(FutexSemaphore &sem, int op, uint32_t value, timespec const *timeout)
+    {
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&sem.sequence), op, value, timeout, nullptr, 0);
+    }
+};
+#endif
+
+/**
+ * @brief Bundles a mutex and semaphore type with their traits, for `PolicyTimeoutQueue`.
+ */
+template <typename TMutex, typename TMutexTrait, typename TSemaphore, typename TSemaphoreTrait> struct LockPolicy
+{
+    using Mutex = TMutex;
+    using MutexTrait = TMutexTrait;
+    using Semaphore = TSemaphore;
+    using SemaphoreTrait = TSemaphoreTrait;
+};
+
+/// `std::mutex` with `std::condition_variable`.
+using StdLockPolicy = LockPolicy<std::mutex, LockableTrait<std::mutex>, std::condition_variable, StdSemaphoreTrait>;
+
+/// Single-threaded use: no locking and no blocking.
+using NullLockPolicy = LockPolicy<NullMutex, NullMutexTrait, NullSemaphore, NullSemaphoreTrait>;
+
+#if defined(__linux__)
+/// Spinning locks block waiters on a futex on Linux.
+template <typename TMutex>
+using SpinningLockPolicy = LockPolicy<TMutex, LockableTrait<TMutex>, FutexSemaphore,
+                                      FutexSemaphoreTrait<LockableTrait<TMutex>>>;
+#else
+/// Spinning locks block waiters on a `std::condition_variable_any` where there is no futex.
+template <typename TMutex>
+using SpinningLockPolicy = LockPolicy<TMutex, LockableTrait<TMutex>, std::condition_variable_any,
+                                      CondVarSemaphoreTrait<LockableTrait<TMutex>>>;
+#endif
+
+/// `SpinLock` for short critical sections.
+using SpinLockPolicy = SpinningLockPolicy<SpinLock>;
+
+/// `TicketLock` for short critical sections with FIFO fairness.
+using TicketLockPolicy = SpinningLockPolicy<TicketLock>;
+
+} // namespace fcp
+
+#endif // TRAITS_HPP
@@ -1,11 +1,14 @@
-#ifndef TIMEOUT_QUEUE_HPP
-#define TIMEOUT_QUEUE_HPP
+#ifndef UNIQUE_ID_QUEUE_HPP
+#define UNIQUE_ID_QUEUE_HPP
 
+#include "IndexPolicy.hpp"
 #include "Queue.hpp"
+#include "QueueStats.hpp"
 #include <algorithm>
 #include <array>
 #include <cstdint>
 #include <limits>
+#include <span>
 #include <utility>
 
 namespace fcp
@@ -15,27 +18,43 @@ namespace fcp
  * @brief A fixed-capacity, thread-safe queue with O(1) random removal and no duplicate elements.
  *
  * The TimeoutQueue class provides a queue-like container with the following features:
- * - No duplicate elements: Each element is uniquely identified by its `GetId()` method, and only one instance of each
- * ID can exist in the queue at a time.
+ * - No duplicate elements: Each element is uniquely identified by its key (by default its `GetId()` method), and only
+ * one instance of each ID can exist in the queue at a time.
  * - O(1) random removal: Elements can be removed from any position in the queue in constant time using their ID.
  * - No dynamic memory allocation: All storage is preallocated based on the specified capacity.
+ * - Usable in constant expressions: Every operation is `constexpr`, so an initial queue state can be built at compile
+ * time, e.g. as a `constexpr` table of `const` elements, and copied into place without any startup work.
  *
- * @tparam T               The type of elements stored in the queue. Must provide `uint16_t GetId() const`.
+ * The width of the `prev`/`next` links is chosen from `Capacity` (see `LinkIndex`), so e.g. a 4096-slot queue uses
+ * 16-bit links instead of `std::size_t`.
+ *
+ * @tparam T               The type of elements stored in the queue. With the default key trait it must provide an
+ *                         unsigned `GetId() const`.
+ * @tparam Capacity        Number of node slots, i.e. the ID range `0 .. Capacity - 1`. May exceed the `uint16_t`
+ *                         range when the key type is wide enough.
+ * @tparam Layout          Layout of the node table. `NodeLayout::Split` keeps the links apart from the data
+ *                         pointers, which helps when `remove()` traffic dominates.
+ * @tparam TKey            Key trait providing `static Key key(T const &)`, see `GetIdKey`.
+ * @tparam TStats          Statistics policy, see `NoStats` and `QueueStats`.
  */
-template <typename T, std::size_t Capacity> class UniqueIdQueue : public Queue
+template <typename T, std::size_t Capacity, NodeLayout Layout = NodeLayout::Interleaved, typename TKey = GetIdKey,
+          typename TStats = NoStats>
+class UniqueIdQueue : public Queue
 {
-    static_assert(std::is_same<decltype(std::declval<const T &>().GetId()), uint16_t>::value,
-                  "UniqueIdQueue requires T to have a method `uint16_t GetId() const`");
+    using Key = KeyType<TKey, T>;
 
-    using Status = Queue::Status;
+    static_assert(std::is_integral_v<Key> && std::is_unsigned_v<Key>,
+                  "UniqueIdQueue requires the key trait to return an unsigned integer ID");
+    static_assert(Capacity > 0 && Capacity - 1 <= std::numeric_limits<Key>::max(),
+                  "UniqueIdQueue Capacity exceeds the range of the key type");
 
-    constexpr uint16_t GetId(T const &c)
-    {
-        return c->GetId();
-    }
+    using Status = Queue::Status;
 
   public:
-    explicit constexpr UniqueIdQueue(uint16_t capacity) : capacity_{capacity}
+    /**
+     * @brief Constructs a UniqueIdQueue that accepts IDs below `capacity` (clamped to `Capacity`).
+     */
+    explicit constexpr UniqueIdQueue(std::size_t capacity) : capacity_{std::min(capacity, Capacity)}
     {
     }
 
@@ -50,26 +69,28 @@ template <typename T, std::size_t Capacity> class UniqueIdQueue : public Queue
 
         if (full())
         {
+            stats_.on_reject(Status::Full);
             return Status::Full;
         }
 
-        auto const id = c.GetId();
+        auto const id = TKey::key(c);
 
         if (!IdValid(id))
         {
             return Status::InvalidId;
         }
 
-        auto &node = data_[id];
-
-        if (node)
+        if (occupied(id))
         {
+            stats_.on_reject(Status::Duplicate);
             return Status::Duplicate;
         }
 
-        node.data = &c;
-        link(node);
+        data_.data(id) = &c;
+        data_.epoch(id) = epoch_;
+        link(id);
         size_++;
+        stats_.on_push(1, size_);
 
         return Status::Ok;
     }
@@ -82,7 +103,7 @@ template <typename T, std::size_t Capacity> class UniqueIdQueue : public Queue
             return Status::Empty;
         }
 
-        out = data_[head_].data;
+        out = data_.data(head_);
 
         return Status::Ok;
     }
@@ -91,47 +112,177 @@ template <typename T, std::size_t Capacity> class UniqueIdQueue : public Queue
     {
         if (empty())
         {
+            stats_.on_reject(Status::Empty);
             return Status::Empty;
         }
 
-        out = data_[head_].data;
-        unlink(data_[head_]);
+        out = data_.data(head_);
+        unlink(head_);
         size_--;
+        stats_.on_pop(1);
 
         return Status::Ok;
     }
 
+    /**
+     * @brief Pushes the elements of the range in order until one is rejected.
+     *
+     * @param elements Pointers to the elements to push.
+     * @return Number of elements pushed. If it is less than `elements.size()`, the element at that index was null or
+     *         rejected by `push()` (full, duplicate or invalid ID) and it and all following elements were not pushed.
+     */
+    constexpr std::size_t push_n(std::span<T *const> elements)
+    {
+        std::size_t n = 0;
+        for (auto *c : elements)
+        {
+            if (c == nullptr || push(*c) != Status::Ok)
+            {
+                break;
+            }
+            ++n;
+        }
+        return n;
+    }
+
+    /**
+     * @brief Removes up to `out.size()` elements in FIFO order into `out`; returns how many were popped.
+     */
+    constexpr std::size_t pop_n(std::span<T *> out)
+    {
+        std::size_t n = 0;
+        while (n < out.size() && !empty())
+        {
+            out[n++] = data_.data(head_);
+            unlink(head_);
+            size_--;
+        }
+        stats_.on_pop(n);
+        if (n == 0 && !out.empty())
+        {
+            stats_.on_reject(Status::Empty);
+        }
+        return n;
+    }
+
     constexpr Status remove(T &c)
     {
 
         if (empty())
         {
+            stats_.on_reject(Status::Empty);
             return Status::Empty;
         }
 
-        auto const id = c.GetId();
+        auto const id = TKey::key(c);
         return remove(id);
     }
 
-    constexpr Status remove(uint16_t id)
+    constexpr Status remove(Key id)
     {
         if (!IdValid(id))
         {
             return Status::InvalidId;
         }
 
-        auto &node = data_[id];
-        if (!node)
+        if (!occupied(id))
         {
             return Status::NotFound;
         }
 
-        unlink(node);
+        unlink(id);
         size_--;
+        stats_.on_remove(1);
 
         return Status::Ok;
     }
 
+    /**
+     * @brief Calls `visitor(T &)` for every queued element in FIFO order without modifying the queue.
+     *
+     * The visitor must not push to or remove from the queue.
+     */
+    template <typename Visitor> constexpr void for_each(Visitor &&visitor) const
+    {
+        for (auto id = head_; id != kNil; id = data_.next(id))
+        {
+            visitor(*data_.data(id));
+        }
+    }
+
+    /**
+     * @brief Empties the queue in one pass, calling `visitor(T &)` for every element in FIFO order.
+     *
+     * Unlike repeated `pop()`, the nodes are reset as they are visited instead of being unlinked one by one.
+     *
+     * @return Number of elements removed.
+     */
+    template <typename Visitor> constexpr std::size_t drain(Visitor &&visitor)
+    {
+        auto const n = size_;
+        stats_.on_remove(n);
+        auto id = head_;
+        head_ = kNil;
+        tail_ = kNil;
+        size_ = 0;
+        while (id != kNil)
+        {
+            auto const next = data_.next(id);
+            auto *const c = data_.data(id);
+            data_.prev(id) = kNil;
+            data_.next(id) = kNil;
+            data_.data(id) = nullptr;
+            visitor(*c);
+            id = next;
+        }
+        return n;
+    }
+
+    /**
+     * @brief Removes every element for which `pred(T const &)` returns true, in one pass over the list.
+     *
+     * The remaining elements keep their order.
+     *
+     * @return Number of elements removed.
+     */
+    template <typename Predicate> constexpr std::size_t remove_if(Predicate &&pred)
+    {
+        std::size_t n = 0;
+        auto id = head_;
+        while (id != kNil)
+        {
+            auto const next = data_.next(id);
+            if (pred(static_cast<T const &>(*data_.data(id))))
+            {
+                unlink(id);
+                ++n;
+            }
+            id = next;
+        }
+        size_ -= n;
+        stats_.on_remove(n);
+        return n;
+    }
+
+    /**
+     * @brief Removes all elements in O(1).
+     *
+     * Only the list header is reset; the nodes are invalidated by advancing the epoch instead of being walked. Once
+     * every 65535 calls the epoch wraps and the node table is reset in full.
+     */
+    constexpr void clear()
+    {
+        stats_.on_remove(size_);
+        head_ = kNil;
+        tail_ = kNil;
+        size_ = 0;
+        if (++epoch_ == 0)
+        {
+            data_ = Storage{};
+            epoch_ = 1;
+        }
+    }
+
     constexpr std::size_t size() const
     {
         return size_;
@@ -147,71 +298,80 @@ template <typename T, std::size_t Capacity> class UniqueIdQueue : public Queue
         return size_ == 0;
     }
 
+    /**
+     * @brief Returns the statistics policy, e.g. for `stats().snapshot()` with `QueueStats`.
+     */
+    constexpr TStats const &stats() const
+    {
+        return stats_;
+    }
+
   private:
-    static constexpr std::size_t kNil{std::numeric_limits<std::size_t>::max()};
+    using Storage = NodeStorage<T, Capacity, Layout>;
+    using Index = typename Storage::Index;
+    static constexpr Index kNil{Storage::kNil};
 
-    struct Node
+    constexpr bool IdValid(std::size_t id) const
     {
-        std::size_t prev{kNil};
-        std::size_t next{kNil};
-        T *data{nullptr};
-        constexpr operator bool() const
-        {
-            return data != nullptr;
-        }
-    };
+        return id < capacity_;
+    }
 
-    constexpr bool IdValid(uint16_t id) const
+    // Nodes left over from before the last clear() carry an older epoch and count as free
+    constexpr bool occupied(std::size_t id) const
     {
-        return id < capacity_;
+        return data_.epoch(id) == epoch_ && data_.data(id) != nullptr;
     }
 
-    constexpr void link(Node &n)
+    constexpr void link(std::size_t id)
     {
-        auto const id = n.data->GetId();
-        n.prev = tail_;
-        n.next = kNil;
+        auto const idx = static_cast<Index>(id);
+        data_.prev(id) = tail_;
+        data_.next(id) = kNil;
         if (tail_ != kNil)
         {
-            data_[tail_].next = id;
+            data_.next(tail_) = idx;
         }
         else
         {
-            head_ = id;
+            head_ = idx;
         }
-        tail_ = id;
+        tail_ = idx;
     }
 
-    constexpr void unlink(Node &n)
+    constexpr void unlink(std::size_t id)
     {
-        if (n.prev != kNil)
+        auto const prev = data_.prev(id);
+        auto const next = data_.next(id);
+        if (prev != kNil)
         {
-            data_[n.prev].next = n.next;
+            data_.next(prev) = next;
         }
         else
         {
-            head_ = n.next;
+            head_ = next;
         }
-        if (n.next != kNil)
+        if (next != kNil)
         {
-            data_[n.next].prev = n.prev;
+            data_.prev(next) = prev;
         }
         else
         {
-            tail_ = n.prev;
+            tail_ = prev;
         }
-        n.prev = kNil;
-        n.next = kNil;
-        n.data = nullptr;
+        data_.prev(id) = kNil;
+        data_.next(id) = kNil;
+        data_.data(id) = nullptr;
     }
 
     std::size_t size_{0};
-    uint16_t capacity_;
-    std::size_t head_ = kNil;
-    std::size_t tail_ = kNil;
-    std::array<Node, Capacity> data_;
+    std::size_t capacity_;
+    Index head_ = kNil;
+    Index tail_ = kNil;
+    Epoch epoch_{1};
+    Storage data_;
+    [[no_unique_address]] TStats stats_;
 };
 
 } // namespace fcp
 
-#endif
\ No newline at end of file
+#endif // UNIQUE_ID_QUEUE_HPP
@@ -0,0 +1,172 @@
+#ifndef WORK_STEALING_DEQUE_HPP
+#define WORK_STEALING_DEQUE_HPP
+
+#include "Platform.hpp"
+#include "Queue.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace fcp
+{
+
+/**
+ * @brief A fixed-capacity, lock-free Chase-Lev work-stealing deque.
+ *
+ * One owner thread pushes and pops at the bottom, in LIFO order, while any number of thief threads steal from the
+ * top, in FIFO order:
+ * - Owner operations touch only the bottom index in the common case and synchronize with thieves through a single
+ *   compare-and-swap on the top index when they race for the last element.
+ * - Thieves claim the oldest element with a compare-and-swap on the top index; a thief that loses the race retries,
+ *   so `steal()` only reports Status::Empty when the deque really was empty.
+ * - Top and bottom live on separate cache lines, so the owner does not bounce the thieves' line on every push.
+ * - No dynamic memory allocation: The ring does not grow; `push()` reports Status::Full instead.
+ *
+ * Slots are atomics, because a thief may read a slot concurrently with the owner releasing it again, so `T` is
+ * expected to be a small trivially copyable handle such as a task pointer.
+ *
+ * @tparam T        The type of elements stored in the deque. Must be trivially copyable.
+ * @tparam Capacity Maximum number of elements in the deque.
+ */
+template <typename T, std::size_t Capacity> class WorkStealingDeque : public Queue
+{
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque requires a trivially copyable T");
+    static_assert(Capacity > 0, "WorkStealingDeque requires a Capacity greater than zero");
+
+    using Status = Queue::Status;
+    using Index = int64_t;
+
+    static constexpr Index kCapacity{static_cast<Index>(Capacity)};
+
+  public:
+    WorkStealingDeque() = default;
+    ~WorkStealingDeque() = default;
+
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+    WorkStealingDeque(WorkStealingDeque &&) = delete;
+    WorkStealingDeque &operator=(WorkStealingDeque &&) = delete;
+
+    /**
+     * @brief Adds an element at the bottom. Must only be called from the owner thread.
+     *
+     * @return Status::Ok on success, Status::Full if the deque is full.
+     */
+    Status push(T const &element)
+    {
+        auto const bottom = bottom_.load(std::memory_order_relaxed);
+        auto const top = top_.load(std::memory_order_acquire);
+        if (bottom - top >= kCapacity)
+        {
+            return Status::Full;
+        }
+
+        slot(bottom).store(element, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_release);
+
+        return Status::Ok;
+    }
+
+    /**
+     * @brief Removes the most recently pushed element. Must only be called from the owner thread.
+     *
+     * @param[out] out Receives the removed element.
+     * @return Status::Ok on success, Status::Empty if the deque is empty or a thief took the last element.
+     */
+    Status pop(T &out)
+    {
+        auto const bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(bottom, std::memory_order_relaxed);
+        // Pairs with the fence in steal(): either the thief sees the lowered bottom or the owner sees its claim
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return Status::Empty;
+        }
+
+        out = slot(bottom).load(std::memory_order_relaxed);
+        if (top < bottom)
+        {
+            return Status::Ok;
+        }
+
+        // Last element: race the thieves for it
+        auto const won =
+            top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return won ? Status::Ok : Status::Empty;
+    }
+
+    /**
+     * @brief Removes the oldest element. May be called from any thread.
+     *
+     * @param[out] out Receives the removed element.
+     * @return Status::Ok on success, Status::Empty if the deque is empty.
+     */
+    Status steal(T &out)
+    {
+        while (true)
+        {
+            auto top = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto const bottom = bottom_.load(std::memory_order_acquire);
+            if (top >= bottom)
+            {
+                return Status::Empty;
+            }
+
+            auto const element = slot(top).load(std::memory_order_relaxed);
+            if (top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                out = element;
+                return Status::Ok;
+            }
+            cpu_relax();
+        }
+    }
+
+    /**
+     * @brief Returns the number of queued elements.
+     *
+     * @note When called concurrently with the owner or thieves the result is a snapshot that may already be stale.
+     */
+    std::size_t size() const
+    {
+        auto const top = top_.load(std::memory_order_acquire);
+        auto const bottom = bottom_.load(std::memory_order_acquire);
+        return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+
+    bool full() const
+    {
+        return size() == Capacity;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+  private:
+    std::atomic<T> &slot(Index i)
+    {
+        return data_[static_cast<std::size_t>(i % kCapacity)];
+    }
+
+    // Claimed by thieves and, for the last element, by the owner
+    alignas(kCacheLineSize) std::atomic<Index> top_{0};
+    // Written only by the owner
+    alignas(kCacheLineSize) std::atomic<Index> bottom_{0};
+
+    alignas(kCacheLineSize) std::array<std::atomic<T>, Capacity> data_{};
+};
+
+} // namespace fcp
+
+#endif // WORK_STEALING_DEQUE_HPP
@@ -0,0 +1,210 @@
+#include "ContainerQueue/ShardedTimeoutQueue.hpp"
+#include "ContainerQueue/TimeoutQueue.hpp"
+#include "ContainerQueue/Traits.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <span>
+#include <thread>
+#include <vector>
+
+// Hammers the blocking paths with more consumers than producers, so that pops keep parking in the semaphore and
+// waking up again. Built with -fsanitize=thread when ENABLE_TSAN is set; without it, it still checks that every
+// element comes out exactly once.
+
+using Status = fcp::Queue::Status;
+
+namespace
+{
+
+class Job
+{
+  public:
+    explicit Job(uint16_t id) : id_{id}
+    {
+    }
+    uint16_t GetId() const
+    {
+        return id_;
+    }
+
+  private:
+    uint16_t id_;
+};
+
+constexpr std::size_t kJobs = 512;
+constexpr int kRounds = 8;
+constexpr int kProducers = 2;
+constexpr int kConsumers = 3;
+
+std::vector<Job> make_jobs()
+{
+    std::vector<Job> jobs;
+    jobs.reserve(kJobs);
+    for (uint16_t i = 0; i < kJobs; ++i)
+    {
+        jobs.emplace_back(i);
+    }
+    return jobs;
+}
+
+template <typename TPolicy> class TimeoutQueueStress : public ::testing::Test
+{
+};
+
+using Policies = ::testing::Types<fcp::StdLockPolicy, fcp::SpinLockPolicy, fcp::SpinningLockPolicy<std::mutex>>;
+TYPED_TEST_SUITE(TimeoutQueueStress, Policies);
+
+// Consumers block on an empty queue, alternating between pop and pop_n
+TYPED_TEST(TimeoutQueueStress, BlockingPop)
+{
+    auto jobs = make_jobs();
+    fcp::PolicyTimeoutQueue<Job, TypeParam, kJobs> q;
+    std::array<std::atomic<int>, kJobs> seen{};
+
+    for (int round = 0; round < kRounds; ++round)
+    {
+        std::atomic<std::size_t> popped{0};
+        std::vector<std::thread> threads;
+        for (int p = 0; p < kProducers; ++p)
+        {
+            threads.emplace_back([&, p] {
+                for (std::size_t i = p; i < kJobs; i += kProducers)
+                {
+                    EXPECT_EQ(q.push(jobs[i], -1), Status::Ok);
+                }
+            });
+        }
+        for (int c = 0; c < kConsumers; ++c)
+        {
+            threads.emplace_back([&, c] {
+                std::array<Job *, 4> batch{};
+                while (popped.load() < kJobs)
+                {
+                    std::size_t n = 0;
+                    if (c == 0)
+                    {
+                        n = q.pop_n(std::span<Job *>(batch), 1000);
+                    }
+                    else if (q.pop(batch[0], 1000) == Status::Ok)
+                    {
+                        n = 1;
+                    }
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        seen[batch[i]->GetId()].fetch_add(1);
+                    }
+                    popped.fetch_add(n);
+                }
+            });
+        }
+        for (auto &t : threads)
+        {
+            t.join();
+        }
+        EXPECT_TRUE(q.empty());
+    }
+
+    for (auto const &count : seen)
+    {
+        EXPECT_EQ(count.load(), kRounds);
+    }
+}
+
+// Removals race the blocked consumers; every element is either popped or removed, never both
+TYPED_TEST(TimeoutQueueStress, RemoveRacesBlockedPop)
+{
+    auto jobs = make_jobs();
+    fcp::PolicyTimeoutQueue<Job, TypeParam, kJobs> q;
+    std::array<std::atomic<int>, kJobs> seen{};
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < kConsumers; ++c)
+    {
+        consumers.emplace_back([&] {
+            Job *out = nullptr;
+            while (!done.load() || !q.empty())
+            {
+                if (q.pop(out, 1000) == Status::Ok)
+                {
+                    seen[out->GetId()].fetch_add(1);
+                }
+            }
+        });
+    }
+    for (int round = 0; round < kRounds; ++round)
+    {
+        for (auto &job : jobs)
+        {
+            EXPECT_EQ(q.push(job, -1), Status::Ok);
+            if (job.GetId() % 3 == 0 && q.remove(job) == Status::Ok)
+            {
+                seen[job.GetId()].fetch_add(1);
+            }
+        }
+        while (!q.empty())
+        {
+            std::this_thread::yield();
+        }
+    }
+    done.store(true);
+    for (auto &t : consumers)
+    {
+        t.join();
+    }
+
+    for (auto const &count : seen)
+    {
+        EXPECT_EQ(count.load(), kRounds);
+    }
+}
+
+TEST(ShardedTimeoutQueueStress, BlockedPopsAcrossShards)
+{
+    auto jobs = make_jobs();
+    fcp::ShardedTimeoutQueue<Job, std::mutex, std::condition_variable, fcp::LockableTrait<std::mutex>,
+                             fcp::StdSemaphoreTrait, 4, kJobs>
+        q;
+    std::array<std::atomic<int>, kJobs> seen{};
+    std::atomic<std::size_t> popped{0};
+
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < kConsumers; ++c)
+    {
+        consumers.emplace_back([&, c] {
+            Job *out = nullptr;
+            while (popped.load() < kJobs * kRounds)
+            {
+                if (q.pop(out, 1000, c) == Status::Ok)
+                {
+                    seen[out->GetId()].fetch_add(1);
+                    popped.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (int round = 0; round < kRounds; ++round)
+    {
+        for (auto &job : jobs)
+        {
+            while (q.push(job) != Status::Ok)
+            {
+                // Still queued from the previous round
+                std::this_thread::yield();
+            }
+        }
+    }
+    for (auto &t : consumers)
+    {
+        t.join();
+    }
+
+    for (auto const &count : seen)
+    {
+        EXPECT_EQ(count.load(), kRounds);
+    }
+}
+
+} // namespace
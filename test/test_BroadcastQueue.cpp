@@ -0,0 +1,130 @@
+#include "ContainerQueue/BroadcastQueue.hpp"
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using fcp::BroadcastQueue;
+using Status = fcp::Queue::Status;
+
+TEST(BroadcastQueueTest, EveryReaderSeesEveryElement)
+{
+    BroadcastQueue<int, 4, 3> q;
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.push(1), Status::Ok);
+    EXPECT_EQ(q.push(2), Status::Ok);
+
+    for (std::size_t r = 0; r < 3; ++r)
+    {
+        int out = 0;
+        EXPECT_EQ(q.size(r), 2u);
+        EXPECT_EQ(q.pop(r, out), Status::Ok);
+        EXPECT_EQ(out, 1);
+        EXPECT_EQ(q.pop(r, out), Status::Ok);
+        EXPECT_EQ(out, 2);
+        EXPECT_EQ(q.pop(r, out), Status::Empty);
+        EXPECT_TRUE(q.empty(r));
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(BroadcastQueueTest, SlowestReaderGatesProducer)
+{
+    BroadcastQueue<int, 4, 2> q;
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(q.push(i), Status::Ok);
+    }
+    EXPECT_TRUE(q.full());
+    EXPECT_EQ(q.push(4), Status::Full);
+
+    // Reader 0 catching up is not enough, reader 1 still holds every slot
+    int out = 0;
+    while (q.pop(0, out) == Status::Ok)
+    {
+    }
+    EXPECT_EQ(q.push(4), Status::Full);
+    EXPECT_EQ(q.size(), 4u);
+
+    EXPECT_EQ(q.pop(1, out), Status::Ok);
+    EXPECT_EQ(out, 0);
+    EXPECT_EQ(q.push(4), Status::Ok);
+    EXPECT_EQ(q.push(5), Status::Full);
+    EXPECT_EQ(q.size(0), 1u);
+    EXPECT_EQ(q.size(1), 4u);
+}
+
+TEST(BroadcastQueueTest, ConsumeBatch)
+{
+    BroadcastQueue<int, 8, 2> q;
+    std::array<int, 6> in{0, 1, 2, 3, 4, 5};
+    EXPECT_EQ(q.push_n(in), 6u);
+    // Only the free slots are filled
+    EXPECT_EQ(q.push_n(in), 2u);
+
+    std::vector<int> seen;
+    EXPECT_EQ(q.consume(0, [&](int const &v) { seen.push_back(v); }, 3), 3u);
+    EXPECT_EQ(seen, (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(q.consume(0, [&](int const &v) { seen.push_back(v); }), 5u);
+    EXPECT_EQ(seen, (std::vector<int>{0, 1, 2, 3, 4, 5, 0, 1}));
+    EXPECT_EQ(q.consume(0, [&](int const &) { FAIL(); }), 0u);
+
+    EXPECT_EQ(q.consume(1, [](int const &) {}), 8u);
+    EXPECT_TRUE(q.empty());
+    // The batch release frees the whole ring at once
+    EXPECT_EQ(q.push_n(in), 6u);
+}
+
+TEST(BroadcastQueueTest, ConcurrentReaders)
+{
+    constexpr std::size_t kReaders = 3;
+    constexpr uint64_t kCount = 20000;
+    BroadcastQueue<uint64_t, 64, kReaders> q;
+
+    std::array<uint64_t, kReaders> sums{};
+    std::array<bool, kReaders> ordered{};
+    std::vector<std::thread> readers;
+    for (std::size_t r = 0; r < kReaders; ++r)
+    {
+        readers.emplace_back([&, r] {
+            uint64_t expected = 0;
+            bool in_order = true;
+            while (expected < kCount)
+            {
+                auto const n = q.consume(r, [&](uint64_t const &v) {
+                    in_order = in_order && v == expected;
+                    sums[r] += v;
+                    ++expected;
+                });
+                if (n == 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+            ordered[r] = in_order;
+        });
+    }
+
+    for (uint64_t i = 0; i < kCount;)
+    {
+        if (q.push(i) == Status::Ok)
+        {
+            ++i;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    for (auto &t : readers)
+    {
+        t.join();
+    }
+
+    for (std::size_t r = 0; r < kReaders; ++r)
+    {
+        EXPECT_TRUE(ordered[r]);
+        EXPECT_EQ(sums[r], kCount * (kCount - 1) / 2);
+    }
+}
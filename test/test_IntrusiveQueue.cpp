@@ -0,0 +1,128 @@
+#include "ContainerQueue/IntrusiveQueue.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace fcp;
+
+namespace
+{
+
+struct Job
+{
+    explicit Job(int value_) : value(value_)
+    {
+    }
+
+    int value;
+    QueueHook<Job> ready;
+    QueueHook<Job> audit;
+};
+
+using ReadyList = IntrusiveQueue<Job, &Job::ready>;
+using AuditList = IntrusiveQueue<Job, &Job::audit>;
+
+std::vector<int> Values(ReadyList const &q)
+{
+    std::vector<int> values;
+    q.for_each([&](Job &j) { values.push_back(j.value); });
+    return values;
+}
+
+TEST(IntrusiveQueueTest, PushPopFront)
+{
+    ReadyList q;
+    Job a(1), b(2), c(3);
+    Job *out = nullptr;
+
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.pop(out), Queue::Status::Empty);
+    EXPECT_EQ(q.front(out), Queue::Status::Empty);
+
+    EXPECT_EQ(q.push(a), Queue::Status::Ok);
+    EXPECT_EQ(q.push(b), Queue::Status::Ok);
+    EXPECT_EQ(q.push(c), Queue::Status::Ok);
+    EXPECT_EQ(q.push(b), Queue::Status::Duplicate);
+    EXPECT_EQ(q.size(), 3u);
+    EXPECT_TRUE(a.ready.linked());
+
+    EXPECT_EQ(q.front(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &a);
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &a);
+    EXPECT_FALSE(a.ready.linked());
+    EXPECT_EQ(Values(q), (std::vector<int>{2, 3}));
+}
+
+TEST(IntrusiveQueueTest, RemoveAnywhere)
+{
+    ReadyList q;
+    ReadyList other;
+    Job a(1), b(2), c(3), d(4);
+    for (auto *j : {&a, &b, &c})
+    {
+        EXPECT_EQ(q.push(*j), Queue::Status::Ok);
+    }
+    EXPECT_EQ(other.push(d), Queue::Status::Ok);
+
+    EXPECT_EQ(q.remove(b), Queue::Status::Ok);
+    EXPECT_EQ(q.remove(b), Queue::Status::NotFound);
+    // Linked into another queue through the same hook
+    EXPECT_EQ(q.remove(d), Queue::Status::NotFound);
+    EXPECT_EQ(q.push(d), Queue::Status::Duplicate);
+    EXPECT_TRUE(other.contains(d));
+    EXPECT_EQ(Values(q), (std::vector<int>{1, 3}));
+
+    EXPECT_EQ(q.remove(c), Queue::Status::Ok);
+    EXPECT_EQ(q.remove(a), Queue::Status::Ok);
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.remove(a), Queue::Status::Empty);
+
+    EXPECT_EQ(q.push(c), Queue::Status::Ok);
+    EXPECT_EQ(q.push(a), Queue::Status::Ok);
+    EXPECT_EQ(Values(q), (std::vector<int>{3, 1}));
+}
+
+TEST(IntrusiveQueueTest, SeparateHooksSeparateQueues)
+{
+    ReadyList ready;
+    AuditList audit;
+    Job a(1), b(2);
+
+    EXPECT_EQ(ready.push(a), Queue::Status::Ok);
+    EXPECT_EQ(audit.push(b), Queue::Status::Ok);
+    EXPECT_EQ(audit.push(a), Queue::Status::Ok);
+
+    Job *out = nullptr;
+    EXPECT_EQ(audit.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &b);
+    EXPECT_TRUE(ready.contains(a));
+    EXPECT_TRUE(audit.contains(a));
+}
+
+TEST(IntrusiveQueueTest, ClearAndDestructionUnlink)
+{
+    Job a(1), b(2);
+    {
+        ReadyList q;
+        EXPECT_EQ(q.push(a), Queue::Status::Ok);
+        EXPECT_EQ(q.push(b), Queue::Status::Ok);
+        q.clear();
+        EXPECT_TRUE(q.empty());
+        EXPECT_FALSE(a.ready.linked());
+        EXPECT_EQ(q.push(b), Queue::Status::Ok);
+    }
+    // The queue went out of scope with b still queued
+    EXPECT_FALSE(b.ready.linked());
+
+    // Copies of an element start out unlinked
+    ReadyList q;
+    EXPECT_EQ(q.push(a), Queue::Status::Ok);
+    Job copy = a;
+    EXPECT_FALSE(copy.ready.linked());
+    EXPECT_EQ(q.push(copy), Queue::Status::Ok);
+    EXPECT_EQ(q.size(), 2u);
+    // copy is destroyed before q, and queued elements must outlive their membership
+    q.clear();
+}
+
+} // namespace
@@ -0,0 +1,176 @@
+#include "ContainerQueue/MpmcQueue.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using fcp::MpmcQueue;
+using Status = fcp::Queue::Status;
+
+namespace
+{
+
+// Semaphore for MpmcQueue: the mutex only protects the sleep/wakeup handshake, not the queue.
+struct CvSemaphore
+{
+    std::mutex mtx;
+    std::condition_variable cv;
+};
+
+struct CvSemaphoreTrait
+{
+    static void init(CvSemaphore &sem)
+    {
+        (void)sem;
+    }
+
+    template <typename Predicate> static bool wait(CvSemaphore &sem, Predicate pred, long timeout_us)
+    {
+        std::unique_lock<std::mutex> lock(sem.mtx);
+        if (timeout_us < 0)
+        {
+            sem.cv.wait(lock, pred);
+            return true;
+        }
+        return sem.cv.wait_for(lock, std::chrono::microseconds(timeout_us), pred);
+    }
+
+    static void notify(CvSemaphore &sem)
+    {
+        {
+            std::lock_guard<std::mutex> lock(sem.mtx);
+        }
+        sem.cv.notify_one();
+    }
+};
+
+using BlockingQueue = MpmcQueue<int, 16, CvSemaphore, CvSemaphoreTrait>;
+
+TEST(MpmcQueueTest, PushPopBasic)
+{
+    MpmcQueue<int, 4> q;
+    int out = 0;
+
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.pop(out), Status::Empty);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(q.push(i), Status::Ok);
+    }
+    EXPECT_TRUE(q.full());
+    EXPECT_EQ(q.size(), 4u);
+    EXPECT_EQ(q.push(4), Status::Full);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(q.pop(out), Status::Ok);
+        EXPECT_EQ(out, i);
+    }
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.pop(out), Status::Empty);
+}
+
+TEST(MpmcQueueTest, WrapAround)
+{
+    MpmcQueue<int, 2> q;
+    int out = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(q.push(i), Status::Ok);
+        EXPECT_EQ(q.push(i + 100), Status::Ok);
+        EXPECT_EQ(q.push(-1), Status::Full);
+        EXPECT_EQ(q.pop(out), Status::Ok);
+        EXPECT_EQ(out, i);
+        EXPECT_EQ(q.pop(out), Status::Ok);
+        EXPECT_EQ(out, i + 100);
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(MpmcQueueTest, ConcurrentPushPop)
+{
+    constexpr int num_threads = 4;
+    constexpr int per_thread = 5000;
+    MpmcQueue<int, 64> q;
+    std::vector<std::thread> threads;
+    std::atomic<long> sum{0};
+    std::atomic<int> popped{0};
+
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < per_thread; ++i)
+            {
+                while (q.push(t * per_thread + i) != Status::Ok)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        threads.emplace_back([&]() {
+            int out = 0;
+            while (popped.load() < num_threads * per_thread)
+            {
+                if (q.pop(out) == Status::Ok)
+                {
+                    sum += out;
+                    ++popped;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto &th : threads)
+        th.join();
+
+    long const n = num_threads * per_thread;
+    EXPECT_EQ(popped, n);
+    EXPECT_EQ(sum, n * (n - 1) / 2);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(MpmcQueueTest, BlockingPopTimeout)
+{
+    BlockingQueue q;
+    int out = 0;
+    EXPECT_EQ(q.pop(out, 1000), Status::Empty);
+    EXPECT_EQ(q.push(7), Status::Ok);
+    EXPECT_EQ(q.pop(out, 1000), Status::Ok);
+    EXPECT_EQ(out, 7);
+}
+
+TEST(MpmcQueueTest, BlockingPopWakesOnPush)
+{
+    BlockingQueue q;
+    std::vector<std::thread> consumers;
+    std::atomic<int> sum{0};
+
+    for (int t = 0; t < 4; ++t)
+    {
+        consumers.emplace_back([&]() {
+            int out = 0;
+            if (q.pop(out, -1) == Status::Ok)
+            {
+                sum += out;
+            }
+        });
+    }
+    for (int i = 1; i <= 4; ++i)
+    {
+        EXPECT_EQ(q.push(i), Status::Ok);
+    }
+    for (auto &th : consumers)
+        th.join();
+
+    EXPECT_EQ(sum, 10);
+    EXPECT_TRUE(q.empty());
+}
+
+} // namespace
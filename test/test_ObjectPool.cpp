@@ -0,0 +1,209 @@
+#include "ContainerQueue/ObjectPool.hpp"
+#include "ContainerQueue/TimeoutQueue.hpp"
+#include "ContainerQueue/Traits.hpp"
+#include "ContainerQueue/UniqueIdQueue.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+using fcp::ObjectPool;
+using Status = fcp::Queue::Status;
+
+namespace
+{
+
+struct Session
+{
+    Session(uint16_t id, std::string name) : id_{id}, name{std::move(name)}
+    {
+        ++alive;
+    }
+    ~Session()
+    {
+        --alive;
+    }
+    Session(const Session &) = delete;
+    Session &operator=(const Session &) = delete;
+
+    uint16_t GetId() const
+    {
+        return id_;
+    }
+
+    static inline int alive = 0;
+
+    uint16_t id_;
+    std::string name;
+};
+
+struct Slot
+{
+    constexpr explicit Slot(uint16_t id, int value = 0) : id_{id}, value{value}
+    {
+    }
+    constexpr uint16_t GetId() const
+    {
+        return id_;
+    }
+
+    uint16_t id_;
+    int value;
+};
+
+TEST(ObjectPoolTest, AcquireHandsOutDenseIds)
+{
+    ObjectPool<Session, 3> pool;
+    Session *a = nullptr, *b = nullptr, *c = nullptr, *d = nullptr;
+
+    EXPECT_TRUE(pool.empty());
+    EXPECT_EQ(pool.available(), 3u);
+    EXPECT_EQ(pool.acquire(a, "a"), Status::Ok);
+    EXPECT_EQ(pool.acquire(b, "b"), Status::Ok);
+    EXPECT_EQ(pool.acquire(c, "c"), Status::Ok);
+    EXPECT_EQ(pool.acquire(d, "d"), Status::Full);
+    EXPECT_TRUE(pool.full());
+    EXPECT_EQ(Session::alive, 3);
+
+    EXPECT_EQ(a->GetId(), 0);
+    EXPECT_EQ(b->GetId(), 1);
+    EXPECT_EQ(c->GetId(), 2);
+    EXPECT_EQ(b->name, "b");
+    EXPECT_EQ(pool.get(1), b);
+    // Objects are laid out in ID order
+    EXPECT_LT(reinterpret_cast<char *>(a), reinterpret_cast<char *>(b));
+    EXPECT_LT(reinterpret_cast<char *>(b), reinterpret_cast<char *>(c));
+}
+
+TEST(ObjectPoolTest, ReleaseReusesIdsLifo)
+{
+    ObjectPool<Session, 4> pool;
+    Session *s[4] = {};
+    for (auto *&p : s)
+    {
+        ASSERT_EQ(pool.acquire(p, "x"), Status::Ok);
+    }
+
+    EXPECT_EQ(pool.release(*s[1]), Status::Ok);
+    EXPECT_EQ(pool.release(*s[3]), Status::Ok);
+    EXPECT_EQ(pool.get(1), nullptr);
+    EXPECT_EQ(pool.size(), 2u);
+    EXPECT_EQ(Session::alive, 2);
+
+    // The most recently released slot comes back first
+    Session *p = nullptr;
+    EXPECT_EQ(pool.acquire(p, "y"), Status::Ok);
+    EXPECT_EQ(p->GetId(), 3);
+    EXPECT_EQ(pool.acquire(p, "z"), Status::Ok);
+    EXPECT_EQ(p->GetId(), 1);
+    EXPECT_EQ(p->name, "z");
+    EXPECT_TRUE(pool.full());
+}
+
+TEST(ObjectPoolTest, RejectsForeignObjects)
+{
+    ObjectPool<Session, 2> pool;
+    Session *a = nullptr;
+    ASSERT_EQ(pool.acquire(a, "a"), Status::Ok);
+
+    Session outsider(0, "outsider");
+    EXPECT_EQ(pool.release(outsider), Status::NotFound);
+    Session wide(7, "wide");
+    EXPECT_EQ(pool.release(wide), Status::InvalidId);
+    Session free_slot(1, "free");
+    EXPECT_EQ(pool.release(free_slot), Status::NotFound);
+
+    EXPECT_EQ(pool.release(*a), Status::Ok);
+    EXPECT_TRUE(pool.empty());
+}
+
+TEST(ObjectPoolTest, DestroysLiveObjects)
+{
+    Session::alive = 0;
+    {
+        ObjectPool<Session, 4> pool;
+        Session *p = nullptr;
+        ASSERT_EQ(pool.acquire(p, "a"), Status::Ok);
+        ASSERT_EQ(pool.acquire(p, "b"), Status::Ok);
+        EXPECT_EQ(Session::alive, 2);
+    }
+    EXPECT_EQ(Session::alive, 0);
+}
+
+struct Picky
+{
+    Picky(uint16_t id, bool fail) : id_{id}
+    {
+        if (fail)
+        {
+            throw std::runtime_error("rejected");
+        }
+    }
+    uint16_t GetId() const
+    {
+        return id_;
+    }
+
+    uint16_t id_;
+};
+
+TEST(ObjectPoolTest, ThrowingConstructorKeepsSlotFree)
+{
+    ObjectPool<Picky, 2> pool;
+    Picky *p = nullptr;
+
+    EXPECT_THROW(pool.acquire(p, true), std::runtime_error);
+    EXPECT_TRUE(pool.empty());
+    EXPECT_EQ(pool.get(0), nullptr);
+
+    // Neither slot was lost
+    Picky *a = nullptr, *b = nullptr;
+    EXPECT_EQ(pool.acquire(a, false), Status::Ok);
+    EXPECT_EQ(a->GetId(), 0);
+    EXPECT_THROW(pool.acquire(p, true), std::runtime_error);
+    EXPECT_EQ(pool.acquire(b, false), Status::Ok);
+    EXPECT_EQ(b->GetId(), 1);
+    EXPECT_TRUE(pool.full());
+}
+
+TEST(ObjectPoolTest, PlugsIntoIdIndexedQueues)
+{
+    constexpr std::size_t kCapacity = 16;
+    ObjectPool<Slot, kCapacity> pool;
+    fcp::PolicyTimeoutQueue<Slot, fcp::StdLockPolicy, kCapacity> queue;
+    fcp::UniqueIdQueue<Slot, kCapacity> ready(kCapacity);
+
+    for (int i = 0; i < 8; ++i)
+    {
+        Slot *s = nullptr;
+        ASSERT_EQ(pool.acquire(s, i * 10), Status::Ok);
+        EXPECT_EQ(queue.push(*s), Status::Ok);
+        EXPECT_EQ(ready.push(*s), Status::Ok);
+    }
+
+    Slot *out = nullptr;
+    for (int i = 0; i < 8; ++i)
+    {
+        ASSERT_EQ(queue.pop(out), Status::Ok);
+        EXPECT_EQ(out->value, i * 10);
+        EXPECT_EQ(ready.remove(*out), Status::Ok);
+        EXPECT_EQ(pool.release(*out), Status::Ok);
+    }
+    EXPECT_TRUE(pool.empty());
+}
+
+constexpr bool ConstexprAcquireRelease()
+{
+    ObjectPool<Slot, 3> pool;
+    Slot *a = nullptr, *b = nullptr, *c = nullptr;
+    bool ok = pool.acquire(a, 1) == Status::Ok && pool.acquire(b, 2) == Status::Ok;
+    Slot outsider(1, 2);
+    ok = ok && pool.release(*a) == Status::Ok && pool.release(outsider) == Status::NotFound;
+    ok = ok && pool.acquire(c, 3) == Status::Ok && c->GetId() == 0 && c->value == 3;
+    ok = ok && pool.get(1) == b && pool.size() == 2;
+    return ok;
+}
+static_assert(ConstexprAcquireRelease());
+static_assert(sizeof(ObjectPool<Slot, 200>) < 200 * (sizeof(Slot) + 2 * sizeof(void *)));
+
+} // namespace
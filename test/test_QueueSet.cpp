@@ -0,0 +1,226 @@
+#include "ContainerQueue/QueueSet.hpp"
+#include "ContainerQueue/TimeoutQueue.hpp"
+#include "ContainerQueue/Traits.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <span>
+#include <thread>
+#include <vector>
+
+using Status = fcp::Queue::Status;
+
+namespace
+{
+
+class Job
+{
+  public:
+    explicit Job(uint16_t id) : id_{id}
+    {
+    }
+    uint16_t GetId() const
+    {
+        return id_;
+    }
+
+  private:
+    uint16_t id_;
+};
+
+using JobQueue = fcp::PolicyTimeoutQueue<Job, fcp::StdLockPolicy, 64>;
+
+TEST(QueueSetTest, PriorityServesEarlierQueuesFirst)
+{
+    JobQueue control, data, retry;
+    fcp::QueueSet<JobQueue, 3> set(control, data, retry);
+    Job a(0), b(1), c(2), d(3);
+    Job *out = nullptr;
+    std::size_t from = 0;
+
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.pop_any(out), Status::Empty);
+
+    EXPECT_EQ(retry.push(a), Status::Ok);
+    EXPECT_EQ(data.push(b), Status::Ok);
+    EXPECT_EQ(data.push(c), Status::Ok);
+    EXPECT_EQ(control.push(d), Status::Ok);
+
+    EXPECT_EQ(set.pop_any_from(out, from), Status::Ok);
+    EXPECT_EQ(out, &d);
+    EXPECT_EQ(from, 0u);
+    EXPECT_EQ(set.pop_any_from(out, from), Status::Ok);
+    EXPECT_EQ(out, &b);
+    EXPECT_EQ(from, 1u);
+    EXPECT_EQ(set.pop_any_from(out, from), Status::Ok);
+    EXPECT_EQ(out, &c);
+    EXPECT_EQ(set.pop_any_from(out, from), Status::Ok);
+    EXPECT_EQ(out, &a);
+    EXPECT_EQ(from, 2u);
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(QueueSetTest, RoundRobinAlternatesBetweenQueues)
+{
+    JobQueue first, second;
+    fcp::QueueSet<JobQueue, 2, fcp::SelectPolicy::RoundRobin> set(first, second);
+    std::vector<Job> jobs;
+    for (uint16_t i = 0; i < 8; ++i)
+    {
+        jobs.emplace_back(i);
+    }
+    for (uint16_t i = 0; i < 6; ++i)
+    {
+        EXPECT_EQ(first.push(jobs[i]), Status::Ok);
+    }
+    EXPECT_EQ(second.push(jobs[6]), Status::Ok);
+    EXPECT_EQ(second.push(jobs[7]), Status::Ok);
+
+    // The busy first queue does not starve the second one
+    std::vector<std::size_t> order;
+    Job *out = nullptr;
+    std::size_t from = 0;
+    while (set.pop_any_from(out, from) == Status::Ok)
+    {
+        order.push_back(from);
+    }
+    EXPECT_EQ(order, (std::vector<std::size_t>{0, 1, 0, 1, 0, 0, 0, 0}));
+}
+
+TEST(QueueSetTest, PopAnyTimesOut)
+{
+    JobQueue first, second;
+    fcp::QueueSet<JobQueue, 2> set(first, second);
+    Job *out = nullptr;
+
+    auto const start = std::chrono::steady_clock::now();
+    EXPECT_EQ(set.pop_any(out, 2000), Status::Empty);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::microseconds(2000));
+}
+
+// A consumer blocked in the set wakes up for a push to any member
+TEST(QueueSetTest, BlockedConsumerWakesForAnyQueue)
+{
+    JobQueue control, data, retry;
+    fcp::QueueSet<JobQueue, 3> set(control, data, retry);
+    Job a(0), b(1), c(2);
+    JobQueue *queues[] = {&control, &data, &retry};
+    Job *jobs[] = {&c, &a, &b};
+
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        Job *out = nullptr;
+        std::size_t from = 99;
+        std::thread consumer([&] { EXPECT_EQ(set.pop_any_from(out, from, -1), Status::Ok); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        EXPECT_EQ(queues[i]->push(*jobs[i]), Status::Ok);
+        consumer.join();
+        EXPECT_EQ(out, jobs[i]);
+        EXPECT_EQ(from, i);
+    }
+}
+
+TEST(QueueSetTest, PushBatchWakesSeveralConsumers)
+{
+    constexpr int kConsumers = 3;
+    JobQueue first, second;
+    fcp::QueueSet<JobQueue, 2> set(first, second);
+    std::vector<Job> jobs;
+    std::vector<Job *> batch;
+    for (uint16_t i = 0; i < kConsumers; ++i)
+    {
+        jobs.emplace_back(i);
+    }
+    for (auto &job : jobs)
+    {
+        batch.push_back(&job);
+    }
+
+    std::atomic<int> popped{0};
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < kConsumers; ++i)
+    {
+        consumers.emplace_back([&] {
+            Job *out = nullptr;
+            if (set.pop_any(out, 500000) == Status::Ok)
+            {
+                popped.fetch_add(1);
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    auto const start = std::chrono::steady_clock::now();
+    EXPECT_EQ(second.push_n(std::span<Job *const>(batch)), batch.size());
+    for (auto &t : consumers)
+    {
+        t.join();
+    }
+    EXPECT_EQ(popped.load(), kConsumers);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(250));
+}
+
+TEST(QueueSetTest, ProducersAndConsumersAcrossQueues)
+{
+    constexpr std::size_t kJobs = 60;
+    JobQueue control, data, retry;
+    fcp::QueueSet<JobQueue, 3, fcp::SelectPolicy::RoundRobin> set(control, data, retry);
+    JobQueue *queues[] = {&control, &data, &retry};
+    std::vector<Job> jobs;
+    for (uint16_t i = 0; i < kJobs; ++i)
+    {
+        jobs.emplace_back(i);
+    }
+
+    std::atomic<std::size_t> popped{0};
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 2; ++c)
+    {
+        consumers.emplace_back([&] {
+            Job *out = nullptr;
+            while (popped.load() < kJobs)
+            {
+                if (set.pop_any(out, 1000) == Status::Ok)
+                {
+                    popped.fetch_add(1);
+                }
+            }
+        });
+    }
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p < 3; ++p)
+    {
+        producers.emplace_back([&, p] {
+            for (std::size_t i = p; i < kJobs; i += 3)
+            {
+                EXPECT_EQ(queues[p]->push(jobs[i]), Status::Ok);
+            }
+        });
+    }
+    for (auto &t : producers)
+    {
+        t.join();
+    }
+    for (auto &t : consumers)
+    {
+        t.join();
+    }
+    EXPECT_EQ(popped.load(), kJobs);
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(QueueSetTest, QueuesOutliveTheSet)
+{
+    JobQueue first, second;
+    Job a(0);
+    {
+        fcp::QueueSet<JobQueue, 2> set(first, second);
+    }
+    // The listener is gone again; pushes and pops work as before
+    Job *out = nullptr;
+    EXPECT_EQ(first.push(a), Status::Ok);
+    EXPECT_EQ(first.pop(out), Status::Ok);
+    EXPECT_EQ(out, &a);
+}
+
+} // namespace
@@ -0,0 +1,149 @@
+#include "ContainerQueue/ReadyQueue.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace fcp;
+
+namespace
+{
+
+struct Task
+{
+    uint16_t id;
+    explicit constexpr Task(uint16_t id_) : id(id_)
+    {
+    }
+    constexpr uint16_t GetId() const
+    {
+        return id;
+    }
+};
+
+constexpr std::size_t kCapacity = 8;
+constexpr std::size_t kLevels = 4;
+
+using QueueT = ReadyQueue<Task, kCapacity, kLevels>;
+
+TEST(ReadyQueueTest, HighestPriorityFirst)
+{
+    QueueT q;
+    Task a(0), b(1), c(2), d(3);
+
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.push(a, 1), Queue::Status::Ok);
+    EXPECT_EQ(q.push(b, 3), Queue::Status::Ok);
+    EXPECT_EQ(q.push(c, 1), Queue::Status::Ok);
+    EXPECT_EQ(q.push(d, 0), Queue::Status::Ok);
+    EXPECT_EQ(q.size(), 4u);
+
+    std::size_t prio = 0;
+    EXPECT_EQ(q.top_priority(prio), Queue::Status::Ok);
+    EXPECT_EQ(prio, 3u);
+
+    Task *out = nullptr;
+    EXPECT_EQ(q.front(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &b);
+
+    // Highest level first, FIFO within a level
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &b);
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &a);
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &c);
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &d);
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.pop(out), Queue::Status::Empty);
+    EXPECT_EQ(q.top_priority(prio), Queue::Status::Empty);
+}
+
+TEST(ReadyQueueTest, RejectsInvalidAndDuplicates)
+{
+    QueueT q(2);
+    Task a(0), b(1), c(2);
+
+    EXPECT_EQ(q.push(a, kLevels), Queue::Status::InvalidId);
+    EXPECT_EQ(q.push(c, 0), Queue::Status::InvalidId);
+    EXPECT_EQ(q.push(a, 0), Queue::Status::Ok);
+    EXPECT_EQ(q.push(a, 2), Queue::Status::Duplicate);
+    EXPECT_EQ(q.push(b, 2), Queue::Status::Ok);
+    EXPECT_TRUE(q.full());
+    EXPECT_EQ(q.push(c, 0), Queue::Status::Full);
+}
+
+TEST(ReadyQueueTest, RemoveUpdatesReadyLevels)
+{
+    QueueT q;
+    Task a(0), b(1), c(2);
+    EXPECT_EQ(q.push(a, 2), Queue::Status::Ok);
+    EXPECT_EQ(q.push(b, 2), Queue::Status::Ok);
+    EXPECT_EQ(q.push(c, 1), Queue::Status::Ok);
+
+    EXPECT_EQ(q.remove(a), Queue::Status::Ok);
+    EXPECT_EQ(q.remove(a), Queue::Status::NotFound);
+    EXPECT_EQ(q.remove(uint16_t(1)), Queue::Status::Ok);
+    EXPECT_EQ(q.remove(uint16_t(kCapacity)), Queue::Status::InvalidId);
+
+    // Level 2 is empty now, level 1 is the top
+    std::size_t prio = 0;
+    EXPECT_EQ(q.top_priority(prio), Queue::Status::Ok);
+    EXPECT_EQ(prio, 1u);
+
+    Task *out = nullptr;
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &c);
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.remove(c), Queue::Status::Empty);
+}
+
+TEST(ReadyQueueTest, Reprioritize)
+{
+    QueueT q;
+    Task a(0), b(1), c(2);
+    EXPECT_EQ(q.push(a, 1), Queue::Status::Ok);
+    EXPECT_EQ(q.push(b, 1), Queue::Status::Ok);
+    EXPECT_EQ(q.push(c, 0), Queue::Status::Ok);
+
+    // Same level keeps the position
+    EXPECT_EQ(q.reprioritize(0, 1), Queue::Status::Ok);
+    // Boost c above everything, move a behind b
+    EXPECT_EQ(q.reprioritize(2, 3), Queue::Status::Ok);
+    EXPECT_EQ(q.reprioritize(0, 0), Queue::Status::Ok);
+    EXPECT_EQ(q.reprioritize(0, kLevels), Queue::Status::InvalidId);
+    EXPECT_EQ(q.reprioritize(5, 1), Queue::Status::NotFound);
+    EXPECT_EQ(q.size(), 3u);
+
+    Task *out = nullptr;
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &c);
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &b);
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &a);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(ReadyQueueTest, SixtyFourLevels)
+{
+    ReadyQueue<Task, 64, 64> q;
+    std::vector<Task> tasks;
+    for (uint16_t i = 0; i < 64; ++i)
+    {
+        tasks.emplace_back(i);
+    }
+    for (auto &t : tasks)
+    {
+        EXPECT_EQ(q.push(t, t.GetId()), Queue::Status::Ok);
+    }
+    Task *out = nullptr;
+    for (int i = 63; i >= 0; --i)
+    {
+        EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+        EXPECT_EQ(out->GetId(), i);
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+} // namespace
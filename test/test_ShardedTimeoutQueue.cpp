@@ -0,0 +1,236 @@
+#include "ContainerQueue/ShardedTimeoutQueue.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using Status = fcp::Queue::Status;
+
+namespace
+{
+
+class Item
+{
+  public:
+    explicit Item(uint16_t id) : id_{id}
+    {
+    }
+    uint16_t GetId() const
+    {
+        return id_;
+    }
+
+  private:
+    uint16_t id_;
+};
+
+struct MutexTraits
+{
+    static void init(std::mutex &)
+    {
+    }
+    static void lock(std::mutex &mtx)
+    {
+        mtx.lock();
+    }
+    static void unlock(std::mutex &mtx)
+    {
+        mtx.unlock();
+    }
+};
+
+// Entered and left with the mutex held; it is only released while blocked
+struct SemaphoreTraits
+{
+    static void init(std::condition_variable &)
+    {
+    }
+
+    template <typename Predicate>
+    static bool wait(std::condition_variable &cv, std::mutex &mtx, Predicate pred, long timeout_us = 0)
+    {
+        std::unique_lock<std::mutex> lock(mtx, std::adopt_lock);
+        bool ok = true;
+        if (timeout_us < 0)
+        {
+            cv.wait(lock, pred);
+        }
+        else if (timeout_us == 0)
+        {
+            ok = pred();
+        }
+        else
+        {
+            ok = cv.wait_for(lock, std::chrono::microseconds(timeout_us), pred);
+        }
+        lock.release();
+        return ok;
+    }
+
+    static void notify(std::condition_variable &cv)
+    {
+        cv.notify_one();
+    }
+};
+
+constexpr std::size_t kShards = 4;
+constexpr std::size_t kCapacity = 16;
+
+using QueueT = fcp::ShardedTimeoutQueue<Item, std::mutex, std::condition_variable, MutexTraits, SemaphoreTraits,
+                                        kShards, kCapacity>;
+
+std::vector<Item> MakeItems(std::size_t n)
+{
+    std::vector<Item> items;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        items.emplace_back(static_cast<uint16_t>(i));
+    }
+    return items;
+}
+
+TEST(ShardedTimeoutQueueTest, RoutesByIdRange)
+{
+    static_assert(QueueT::kShardSpan == 4);
+    EXPECT_EQ(QueueT::shard_of(0), 0u);
+    EXPECT_EQ(QueueT::shard_of(3), 0u);
+    EXPECT_EQ(QueueT::shard_of(4), 1u);
+    EXPECT_EQ(QueueT::shard_of(15), 3u);
+
+    QueueT q;
+    auto items = MakeItems(kCapacity);
+    EXPECT_EQ(q.push(items[1]), Status::Ok);
+    EXPECT_EQ(q.push(items[9]), Status::Ok);
+    EXPECT_EQ(q.push(items[10]), Status::Ok);
+    EXPECT_EQ(q.size(), 3u);
+    EXPECT_EQ(q.shard_size(0), 1u);
+    EXPECT_EQ(q.shard_size(1), 0u);
+    EXPECT_EQ(q.shard_size(2), 2u);
+}
+
+TEST(ShardedTimeoutQueueTest, RejectsInvalidDuplicateAndFull)
+{
+    QueueT q(8);
+    auto items = MakeItems(kCapacity);
+    EXPECT_EQ(q.push(items[8]), Status::InvalidId);
+    EXPECT_EQ(q.push(items[2]), Status::Ok);
+    EXPECT_EQ(q.push(items[2]), Status::Duplicate);
+    for (uint16_t i = 0; i < 8; ++i)
+    {
+        if (i != 2)
+        {
+            EXPECT_EQ(q.push(items[i]), Status::Ok);
+        }
+    }
+    EXPECT_TRUE(q.full());
+    EXPECT_EQ(q.push(items[0]), Status::Full);
+}
+
+TEST(ShardedTimeoutQueueTest, HomeShardFirstThenSteal)
+{
+    QueueT q;
+    auto items = MakeItems(kCapacity);
+    // Shard 1 gets 5 then 4, shard 3 gets 12
+    EXPECT_EQ(q.push(items[5]), Status::Ok);
+    EXPECT_EQ(q.push(items[4]), Status::Ok);
+    EXPECT_EQ(q.push(items[12]), Status::Ok);
+
+    Item *out = nullptr;
+    EXPECT_EQ(q.pop(out, 0, 3), Status::Ok);
+    EXPECT_EQ(out, &items[12]);
+    // Shard 3 is empty now, the sweep wraps around to shard 1 and keeps its FIFO order
+    EXPECT_EQ(q.pop(out, 0, 3), Status::Ok);
+    EXPECT_EQ(out, &items[5]);
+    EXPECT_EQ(q.pop(out, 0, 2 + kShards), Status::Ok);
+    EXPECT_EQ(out, &items[4]);
+    EXPECT_EQ(q.pop(out), Status::Empty);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(ShardedTimeoutQueueTest, RemoveLocksOwningShard)
+{
+    QueueT q;
+    auto items = MakeItems(kCapacity);
+    EXPECT_EQ(q.push(items[0]), Status::Ok);
+    EXPECT_EQ(q.push(items[1]), Status::Ok);
+    EXPECT_EQ(q.push(items[2]), Status::Ok);
+
+    EXPECT_EQ(q.remove(items[1]), Status::Ok);
+    EXPECT_EQ(q.remove(items[1]), Status::NotFound);
+    EXPECT_EQ(q.remove(uint16_t(kCapacity)), Status::InvalidId);
+    EXPECT_EQ(q.size(), 2u);
+
+    Item *out = nullptr;
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(out, &items[0]);
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(out, &items[2]);
+}
+
+TEST(ShardedTimeoutQueueTest, BlockingPopWokenByAnyShard)
+{
+    QueueT q;
+    auto items = MakeItems(kCapacity);
+    Item *out = nullptr;
+
+    EXPECT_EQ(q.pop(out, 1000), Status::Empty);
+
+    std::thread consumer([&]() { EXPECT_EQ(q.pop(out, 2000000, 0), Status::Ok); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(q.push(items[14]), Status::Ok);
+    consumer.join();
+    EXPECT_EQ(out, &items[14]);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(ShardedTimeoutQueueTest, ConcurrentProducersAndConsumers)
+{
+    constexpr std::size_t kIds = 1024;
+    constexpr int kRounds = 200;
+    constexpr int kThreads = 4;
+    using BigQueue = fcp::ShardedTimeoutQueue<Item, std::mutex, std::condition_variable, MutexTraits,
+                                              SemaphoreTraits, kThreads, kIds>;
+    auto q = std::make_unique<BigQueue>();
+    auto items = MakeItems(kIds);
+
+    std::atomic<int> popped{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        // Each producer cycles through the IDs of its own shard
+        threads.emplace_back([&, t]() {
+            for (int r = 0; r < kRounds; ++r)
+            {
+                for (std::size_t i = 0; i < BigQueue::kShardSpan; ++i)
+                {
+                    while (q->push(items[t * BigQueue::kShardSpan + i]) != Status::Ok)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        });
+        threads.emplace_back([&, t]() {
+            Item *out = nullptr;
+            for (int n = 0; n < kRounds * static_cast<int>(BigQueue::kShardSpan); ++n)
+            {
+                ASSERT_EQ(q->pop(out, -1, t), Status::Ok);
+                ++popped;
+            }
+        });
+    }
+    for (auto &th : threads)
+    {
+        th.join();
+    }
+
+    EXPECT_EQ(popped, kThreads * kRounds * static_cast<int>(BigQueue::kShardSpan));
+    EXPECT_TRUE(q->empty());
+}
+
+} // namespace
@@ -0,0 +1,162 @@
+#include "ContainerQueue/SharedStaticQueue.hpp"
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <sched.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using Status = fcp::Queue::Status;
+
+namespace
+{
+
+struct Record
+{
+    uint64_t sequence;
+    uint32_t payload[6];
+};
+
+using RecordQueue = fcp::SharedStaticQueue<Record, 8>;
+
+// Unique per process so parallel test runs do not collide
+std::string SegmentName(char const *test)
+{
+    return "/fcp_" + std::string(test) + "_" + std::to_string(::getpid());
+}
+
+class SharedStaticQueueTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        name = SegmentName(::testing::UnitTest::GetInstance()->current_test_info()->name());
+        RecordQueue::unlink(name.c_str());
+    }
+    void TearDown() override
+    {
+        RecordQueue::unlink(name.c_str());
+    }
+
+    std::string name;
+};
+
+TEST_F(SharedStaticQueueTest, TwoMappingsShareOneRing)
+{
+    auto producer = RecordQueue::create(name.c_str());
+    ASSERT_TRUE(producer.has_value());
+    auto consumer = RecordQueue::open(name.c_str());
+    ASSERT_TRUE(consumer.has_value());
+
+    Record out{};
+    EXPECT_EQ(consumer->pop(out), Status::Empty);
+    for (uint64_t i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(producer->push(Record{i, {static_cast<uint32_t>(i)}}), Status::Ok);
+    }
+    EXPECT_EQ(producer->push(Record{8, {}}), Status::Full);
+    EXPECT_TRUE(consumer->full());
+
+    for (uint64_t i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(consumer->pop(out), Status::Ok);
+        EXPECT_EQ(out.sequence, i);
+        EXPECT_EQ(out.payload[0], i);
+    }
+    EXPECT_TRUE(producer->empty());
+}
+
+TEST_F(SharedStaticQueueTest, BatchWrapAround)
+{
+    auto producer = RecordQueue::create(name.c_str());
+    auto consumer = RecordQueue::open(name.c_str());
+    ASSERT_TRUE(producer && consumer);
+
+    std::array<Record, 5> in{};
+    std::array<Record, 5> out{};
+    uint64_t next = 0;
+    uint64_t expected = 0;
+    for (int round = 0; round < 10; ++round)
+    {
+        for (auto &r : in)
+        {
+            r.sequence = next++;
+        }
+        ASSERT_EQ(producer->push_n(in), 5u);
+        ASSERT_EQ(consumer->pop_n(out), 5u);
+        for (auto const &r : out)
+        {
+            EXPECT_EQ(r.sequence, expected++);
+        }
+    }
+    // Only what fits is pushed
+    EXPECT_EQ(producer->push_n(in), 5u);
+    EXPECT_EQ(producer->push_n(in), 3u);
+}
+
+TEST_F(SharedStaticQueueTest, OpenValidatesSegment)
+{
+    EXPECT_FALSE(RecordQueue::open(name.c_str()).has_value());
+
+    auto created = RecordQueue::create(name.c_str());
+    ASSERT_TRUE(created.has_value());
+    // The name is taken
+    EXPECT_FALSE(RecordQueue::create(name.c_str()).has_value());
+    // A different capacity or record type is a different layout
+    EXPECT_FALSE((fcp::SharedStaticQueue<Record, 16>::open(name.c_str()).has_value()));
+    EXPECT_FALSE((fcp::SharedStaticQueue<uint64_t, 8>::open(name.c_str()).has_value()));
+
+    // The mapping outlives the name
+    EXPECT_TRUE(RecordQueue::unlink(name.c_str()));
+    EXPECT_EQ(created->push(Record{1, {}}), Status::Ok);
+    EXPECT_EQ(created->size(), 1u);
+}
+
+TEST_F(SharedStaticQueueTest, CrossProcessHandoff)
+{
+    auto consumer = RecordQueue::create(name.c_str());
+    ASSERT_TRUE(consumer.has_value());
+
+    constexpr uint64_t kRecords = 10000;
+    pid_t const pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0)
+    {
+        auto producer = RecordQueue::open(name.c_str());
+        if (!producer)
+        {
+            ::_exit(1);
+        }
+        for (uint64_t i = 0; i < kRecords;)
+        {
+            if (producer->push(Record{i, {static_cast<uint32_t>(i * 3)}}) == Status::Ok)
+            {
+                ++i;
+                continue;
+            }
+            ::sched_yield();
+        }
+        ::_exit(0);
+    }
+
+    Record out{};
+    for (uint64_t i = 0; i < kRecords;)
+    {
+        if (consumer->pop(out) == Status::Ok)
+        {
+            ASSERT_EQ(out.sequence, i);
+            ASSERT_EQ(out.payload[0], static_cast<uint32_t>(i * 3));
+            ++i;
+            continue;
+        }
+        ::sched_yield();
+    }
+
+    int status = 0;
+    ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+} // namespace
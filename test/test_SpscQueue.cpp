@@ -0,0 +1,86 @@
+#include "ContainerQueue/SpscQueue.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+using fcp::SpscQueue;
+using Status = fcp::Queue::Status;
+
+TEST(SpscQueueTest, PushPopBasic)
+{
+    SpscQueue<int, 3> q;
+    int out = 0;
+
+    EXPECT_TRUE(q.empty());
+    EXPECT_FALSE(q.full());
+    EXPECT_EQ(q.size(), 0u);
+
+    EXPECT_EQ(q.push(1), Status::Ok);
+    EXPECT_EQ(q.push(2), Status::Ok);
+    EXPECT_EQ(q.push(3), Status::Ok);
+    EXPECT_TRUE(q.full());
+    EXPECT_EQ(q.size(), 3u);
+
+    // Queue is full now
+    EXPECT_EQ(q.push(4), Status::Full);
+
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(out, 1);
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(out, 2);
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(out, 3);
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.pop(out), Status::Empty);
+}
+
+TEST(SpscQueueTest, WrapAround)
+{
+    SpscQueue<std::string, 2> q;
+    std::string out;
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(q.push(std::to_string(i)), Status::Ok);
+        EXPECT_EQ(q.push(std::to_string(i + 100)), Status::Ok);
+        EXPECT_EQ(q.push("overflow"), Status::Full);
+        EXPECT_EQ(q.pop(out), Status::Ok);
+        EXPECT_EQ(out, std::to_string(i));
+        EXPECT_EQ(q.pop(out), Status::Ok);
+        EXPECT_EQ(out, std::to_string(i + 100));
+        EXPECT_TRUE(q.empty());
+    }
+}
+
+TEST(SpscQueueTest, ProducerConsumerThreads)
+{
+    constexpr int kCount = 100000;
+    SpscQueue<int, 64> q;
+
+    std::thread producer([&]() {
+        for (int i = 0; i < kCount; ++i)
+        {
+            while (q.push(i) != Status::Ok)
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    while (expected < kCount)
+    {
+        int out = -1;
+        if (q.pop(out) == Status::Ok)
+        {
+            ASSERT_EQ(out, expected);
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(q.empty());
+}
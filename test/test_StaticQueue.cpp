@@ -1,5 +1,8 @@
 #include "ContainerQueue/StaticQueue.hpp"
+#include <array>
 #include <gtest/gtest.h>
+#include <memory>
+#include <span>
 #include <string>
 
 using fcp::StaticQueue;
@@ -122,6 +125,193 @@ TEST(StaticQueueTest, FillAndEmptyMultipleTimes)
     }
 }
 
+TEST(StaticQueueTest, PushPopBatch)
+{
+    StaticQueue<int, 4> q;
+    std::array<int, 5> in{1, 2, 3, 4, 5};
+    std::array<int, 4> out{};
+
+    EXPECT_EQ(q.push_n(in), 4u);
+    EXPECT_TRUE(q.full());
+    EXPECT_EQ(q.push_n(in), 0u);
+
+    EXPECT_EQ(q.pop_n(std::span<int>(out).first(3)), 3u);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], 2);
+    EXPECT_EQ(out[2], 3);
+
+    // Pushed range wraps around the end of the ring
+    EXPECT_EQ(q.push_n(std::span<int const>(in).subspan(2)), 3u);
+    EXPECT_TRUE(q.full());
+
+    EXPECT_EQ(q.pop_n(out), 4u);
+    EXPECT_EQ(out[0], 4);
+    EXPECT_EQ(out[1], 3);
+    EXPECT_EQ(out[2], 4);
+    EXPECT_EQ(out[3], 5);
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.pop_n(out), 0u);
+}
+
+namespace
+{
+
+struct Tracked
+{
+    static inline int alive = 0;
+    explicit Tracked(int v) : value{v}
+    {
+        ++alive;
+    }
+    Tracked(Tracked const &other) : value{other.value}
+    {
+        ++alive;
+    }
+    Tracked(Tracked &&other) noexcept : value{other.value}
+    {
+        ++alive;
+    }
+    Tracked &operator=(Tracked const &) = default;
+    Tracked &operator=(Tracked &&) noexcept = default;
+    ~Tracked()
+    {
+        --alive;
+    }
+    int value;
+};
+
+} // namespace
+
+TEST(StaticQueueTest, MoveOnlyElements)
+{
+    StaticQueue<std::unique_ptr<int>, 2> q;
+    EXPECT_EQ(q.push(std::make_unique<int>(1)), Status::Ok);
+    EXPECT_EQ(q.emplace(new int(2)), Status::Ok);
+    EXPECT_EQ(q.emplace(std::make_unique<int>(3)), Status::Full);
+
+    std::unique_ptr<int> out;
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(*out, 1);
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(*out, 2);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(StaticQueueTest, MoveOutLeavesSourceEmpty)
+{
+    StaticQueue<std::string, 2> q;
+    std::string payload(64, 'x');
+    EXPECT_EQ(q.push(std::move(payload)), Status::Ok);
+
+    std::string out;
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(out, std::string(64, 'x'));
+}
+
+TEST(StaticQueueTest, SlotsConstructedOnlyWhileOccupied)
+{
+    Tracked::alive = 0;
+    {
+        StaticQueue<Tracked, 4> q;
+        EXPECT_EQ(Tracked::alive, 0);
+
+        EXPECT_EQ(q.emplace(1), Status::Ok);
+        EXPECT_EQ(q.emplace(2), Status::Ok);
+        EXPECT_EQ(q.emplace(3), Status::Ok);
+        EXPECT_EQ(Tracked::alive, 3);
+
+        Tracked out(0);
+        EXPECT_EQ(q.pop(out), Status::Ok);
+        EXPECT_EQ(out.value, 1);
+        EXPECT_EQ(Tracked::alive, 3);
+
+        StaticQueue<Tracked, 4> copy = q;
+        EXPECT_EQ(copy.size(), 2u);
+        EXPECT_EQ(Tracked::alive, 5);
+
+        StaticQueue<Tracked, 4> moved = std::move(copy);
+        EXPECT_TRUE(copy.empty());
+        EXPECT_EQ(moved.size(), 2u);
+        EXPECT_EQ(Tracked::alive, 5);
+
+        EXPECT_EQ(moved.pop(out), Status::Ok);
+        EXPECT_EQ(out.value, 2);
+        EXPECT_EQ(Tracked::alive, 4);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(StaticQueueTest, TrivialTypeStaysTrivial)
+{
+    static_assert(std::is_trivially_copyable_v<StaticQueue<int, 4>>);
+    static_assert(std::is_trivially_destructible_v<StaticQueue<int, 4>>);
+    static_assert(!std::is_default_constructible_v<Tracked>);
+    SUCCEED();
+}
+
+TEST(StaticQueueTest, PowerOfTwoWrapAround)
+{
+    static_assert(sizeof(StaticQueue<int, 4>) < sizeof(StaticQueue<int, 3>) + sizeof(int));
+    StaticQueue<int, 4> q;
+    std::array<int, 3> out{};
+    for (int i = 0; i < 20; ++i)
+    {
+        EXPECT_EQ(q.push(i), Status::Ok);
+        EXPECT_EQ(q.push(i + 100), Status::Ok);
+        EXPECT_EQ(q.push(i + 200), Status::Ok);
+        EXPECT_EQ(q.size(), 3u);
+        EXPECT_EQ(q.pop_n(out), 3u);
+        EXPECT_EQ(out[0], i);
+        EXPECT_EQ(out[1], i + 100);
+        EXPECT_EQ(out[2], i + 200);
+        EXPECT_TRUE(q.empty());
+    }
+}
+
+TEST(StaticQueueTest, Pow2Alias)
+{
+    static_assert(std::is_same_v<fcp::StaticQueuePow2<int, 5>, StaticQueue<int, 8>>);
+    static_assert(std::is_same_v<fcp::StaticQueuePow2<int, 8>, StaticQueue<int, 8>>);
+    fcp::StaticQueuePow2<int, 3> q;
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(q.push(i), Status::Ok);
+    }
+    EXPECT_TRUE(q.full());
+    EXPECT_EQ(q.push(4), Status::Full);
+}
+
+TEST(StaticQueueTest, StatsPolicy)
+{
+    // Statistics are opt-in; the default policy adds neither size nor non-trivial members
+    static_assert(std::is_same_v<StaticQueue<int, 4>, StaticQueue<int, 4, fcp::NoStats>>);
+    static_assert(sizeof(StaticQueue<int, 4>) == 2 * sizeof(std::size_t) + 4 * sizeof(int));
+
+    StaticQueue<int, 4, fcp::QueueStats<>> q;
+    int out = 0;
+    EXPECT_EQ(q.pop(out), Status::Empty);
+    std::array<int, 5> in{1, 2, 3, 4, 5};
+    EXPECT_EQ(q.push_n(std::span<int const>(in.data(), 3)), 3u);
+    EXPECT_EQ(q.push(4), Status::Ok);
+    EXPECT_EQ(q.push(5), Status::Full);
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(q.push_n(in), 1u);
+    q.clear();
+
+    auto const s = q.stats().snapshot();
+    EXPECT_EQ(s.pushes, 5u);
+    EXPECT_EQ(s.pops, 1u);
+    EXPECT_EQ(s.removes, 4u);
+    EXPECT_EQ(s.full, 2u);
+    EXPECT_EQ(s.empty, 1u);
+    EXPECT_EQ(s.high_water, 4u);
+    EXPECT_EQ(s.duplicate, 0u);
+
+    // A copy carries the counters along
+    auto copy = q;
+    EXPECT_EQ(copy.stats().snapshot().pushes, 5u);
+}
+
 TEST(StaticQueueTest, CapacityZeroCompileTime)
 {
     // This test will not compile if uncommented, as std::array<T, 0> is valid but not useful.
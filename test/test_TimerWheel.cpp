@@ -0,0 +1,225 @@
+#include "ContainerQueue/TimerWheel.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <vector>
+
+using fcp::TimerWheel;
+
+namespace
+{
+
+constexpr std::size_t kCapacity = 256;
+
+std::vector<std::size_t> Advance(TimerWheel<kCapacity> &wheel, uint64_t now)
+{
+    std::vector<std::size_t> due;
+    wheel.advance(now);
+    std::size_t id = 0;
+    while (wheel.pop_due(id))
+    {
+        due.push_back(id);
+    }
+    return due;
+}
+
+TEST(TimerWheelTest, ExpiresAtDeadline)
+{
+    TimerWheel<kCapacity> wheel;
+    wheel.schedule(1, 5);
+    wheel.schedule(2, 3);
+    EXPECT_TRUE(wheel.scheduled(1));
+    EXPECT_FALSE(wheel.scheduled(3));
+
+    EXPECT_TRUE(Advance(wheel, 2).empty());
+    EXPECT_EQ(Advance(wheel, 3), std::vector<std::size_t>{2});
+    EXPECT_TRUE(Advance(wheel, 4).empty());
+    EXPECT_EQ(Advance(wheel, 5), std::vector<std::size_t>{1});
+    EXPECT_FALSE(wheel.scheduled(1));
+}
+
+TEST(TimerWheelTest, OneAdvanceExpiresEveryDueTimer)
+{
+    TimerWheel<kCapacity> wheel;
+    wheel.schedule(7, 70);
+    wheel.schedule(3, 10);
+    wheel.schedule(5, 10);
+    wheel.schedule(9, 9);
+    wheel.schedule(4, 101);
+
+    // Timers that become due in the same advance() have no defined order
+    auto due = Advance(wheel, 100);
+    std::sort(due.begin(), due.end());
+    EXPECT_EQ(due, (std::vector<std::size_t>{3, 5, 7, 9}));
+    EXPECT_TRUE(wheel.scheduled(4));
+}
+
+TEST(TimerWheelTest, CancelAndReschedule)
+{
+    TimerWheel<kCapacity> wheel;
+    wheel.schedule(1, 10);
+    wheel.schedule(2, 10);
+    EXPECT_TRUE(wheel.cancel(1));
+    EXPECT_FALSE(wheel.cancel(1));
+
+    // Rescheduling moves the timer instead of adding a second one
+    wheel.schedule(2, 20);
+    EXPECT_TRUE(Advance(wheel, 10).empty());
+    EXPECT_EQ(Advance(wheel, 20), std::vector<std::size_t>{2});
+
+    // Cancelling a due timer drops it from the due list
+    wheel.schedule(3, 25);
+    wheel.advance(30);
+    EXPECT_TRUE(wheel.cancel(3));
+    std::size_t id = 0;
+    EXPECT_FALSE(wheel.pop_due(id));
+}
+
+TEST(TimerWheelTest, OverdueTimerIsDueImmediately)
+{
+    TimerWheel<kCapacity> wheel;
+    EXPECT_TRUE(Advance(wheel, 100).empty());
+    wheel.schedule(4, 50);
+    EXPECT_EQ(Advance(wheel, 100), std::vector<std::size_t>{4});
+}
+
+TEST(TimerWheelTest, FarDeadlinesCascade)
+{
+    TimerWheel<kCapacity> wheel;
+    std::vector<uint64_t> deadlines{63, 64, 65, 4095, 4096, 262143, 262144, 16777215, 16777216, 40000000};
+    for (std::size_t i = 0; i < deadlines.size(); ++i)
+    {
+        wheel.schedule(i, deadlines[i]);
+    }
+    for (std::size_t i = 0; i < deadlines.size(); ++i)
+    {
+        EXPECT_TRUE(Advance(wheel, deadlines[i] - 1).empty()) << deadlines[i];
+        EXPECT_EQ(Advance(wheel, deadlines[i]), std::vector<std::size_t>{i}) << deadlines[i];
+    }
+}
+
+TEST(TimerWheelTest, MatchesReferenceModel)
+{
+    TimerWheel<kCapacity> wheel;
+    std::map<std::size_t, uint64_t> model;
+    std::mt19937 rng(42);
+    uint64_t now = 0;
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        auto const id = std::uniform_int_distribution<std::size_t>(0, kCapacity - 1)(rng);
+        switch (rng() % 4)
+        {
+        case 0:
+        case 1: {
+            // Mix of near, mid and far deadlines
+            uint64_t const range = uint64_t{1} << (6 * (rng() % 4) + 6);
+            auto const deadline = now + std::uniform_int_distribution<uint64_t>(0, range)(rng);
+            wheel.schedule(id, deadline);
+            model[id] = deadline;
+            break;
+        }
+        case 2:
+            EXPECT_EQ(wheel.cancel(id), model.erase(id) == 1);
+            break;
+        default: {
+            now += std::uniform_int_distribution<uint64_t>(0, 300)(rng);
+            auto due = Advance(wheel, now);
+            std::vector<std::size_t> expected;
+            for (auto it = model.begin(); it != model.end();)
+            {
+                if (it->second <= now)
+                {
+                    expected.push_back(it->first);
+                    it = model.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            std::sort(due.begin(), due.end());
+            ASSERT_EQ(due, expected) << "now=" << now;
+            break;
+        }
+        }
+    }
+}
+
+TEST(TimerWheelTest, LargeTimeJump)
+{
+    TimerWheel<kCapacity> wheel;
+    wheel.schedule(1, 10);
+    wheel.schedule(2, 50000000);
+    wheel.schedule(3, 90000000);
+    // Timers that become due in the same advance() have no defined order
+    auto due = Advance(wheel, 60000000);
+    std::sort(due.begin(), due.end());
+    EXPECT_EQ(due, (std::vector<std::size_t>{1, 2}));
+    EXPECT_TRUE(Advance(wheel, 89999999).empty());
+    EXPECT_EQ(Advance(wheel, 90000000), std::vector<std::size_t>{3});
+}
+
+// Long gaps below the wheel span jump between occupied slots instead of stepping every tick
+TEST(TimerWheelTest, SparseTimersAcrossLongGaps)
+{
+    TimerWheel<kCapacity> wheel;
+    std::map<std::size_t, uint64_t> model;
+    std::mt19937 rng(7);
+    uint64_t now = 0;
+
+    for (int step = 0; step < 2000; ++step)
+    {
+        auto const id = std::uniform_int_distribution<std::size_t>(0, 15)(rng);
+        if (rng() % 2 == 0)
+        {
+            auto const deadline = now + std::uniform_int_distribution<uint64_t>(0, uint64_t{1} << 24)(rng);
+            wheel.schedule(id, deadline);
+            model[id] = deadline;
+            continue;
+        }
+        now += std::uniform_int_distribution<uint64_t>(0, (uint64_t{1} << 24) - 1)(rng);
+        auto due = Advance(wheel, now);
+        std::vector<std::size_t> expected;
+        for (auto it = model.begin(); it != model.end();)
+        {
+            if (it->second <= now)
+            {
+                expected.push_back(it->first);
+                it = model.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        std::sort(due.begin(), due.end());
+        ASSERT_EQ(due, expected) << "now=" << now;
+    }
+}
+
+TEST(TimerWheelTest, ClearDropsAllTimers)
+{
+    TimerWheel<kCapacity> wheel;
+    wheel.schedule(1, 5);
+    wheel.schedule(2, 100000);
+    wheel.schedule(3, 2);
+    wheel.advance(3);
+
+    wheel.clear();
+    EXPECT_FALSE(wheel.scheduled(1));
+    EXPECT_FALSE(wheel.scheduled(3));
+    EXPECT_FALSE(wheel.cancel(2));
+    std::size_t id = 0;
+    EXPECT_FALSE(wheel.pop_due(id));
+
+    // Stale nodes can be scheduled again and the clock keeps running
+    wheel.schedule(2, 10);
+    wheel.schedule(1, 4);
+    EXPECT_EQ(Advance(wheel, 10), (std::vector<std::size_t>{1, 2}));
+    EXPECT_TRUE(Advance(wheel, 200000).empty());
+}
+
+} // namespace
@@ -0,0 +1,164 @@
+#include "ContainerQueue/TimeoutQueue.hpp"
+#include "ContainerQueue/Traits.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using Status = fcp::Queue::Status;
+
+namespace
+{
+
+class Job
+{
+  public:
+    explicit Job(uint16_t id) : id_{id}
+    {
+    }
+    uint16_t GetId() const
+    {
+        return id_;
+    }
+
+  private:
+    uint16_t id_;
+};
+
+template <typename TLock> void CheckMutualExclusion()
+{
+    TLock lock;
+    constexpr int kThreads = 4;
+    constexpr int kIterations = 20000;
+    // Deliberately not atomic: a lost update means two threads were inside at once
+    long counter = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&] {
+            for (int i = 0; i < kIterations; ++i)
+            {
+                fcp::LockableTrait<TLock>::lock(lock);
+                counter = counter + 1;
+                fcp::LockableTrait<TLock>::unlock(lock);
+            }
+        });
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+    EXPECT_EQ(counter, kThreads * kIterations);
+}
+
+TEST(TraitsTest, SpinLockMutualExclusion)
+{
+    CheckMutualExclusion<fcp::SpinLock>();
+
+    fcp::SpinLock lock;
+    EXPECT_TRUE(lock.try_lock());
+    EXPECT_FALSE(lock.try_lock());
+    lock.unlock();
+    EXPECT_TRUE(lock.try_lock());
+    lock.unlock();
+}
+
+TEST(TraitsTest, TicketLockMutualExclusion)
+{
+    CheckMutualExclusion<fcp::TicketLock>();
+}
+
+TEST(TraitsTest, NullLockPolicyCompilesOut)
+{
+    static_assert(std::is_empty_v<fcp::NullMutex> && std::is_empty_v<fcp::NullSemaphore>);
+    constexpr bool kConstexpr = [] {
+        fcp::NullMutex m;
+        fcp::NullMutexTrait::lock(m);
+        fcp::NullMutexTrait::unlock(m);
+        return true;
+    }();
+    static_assert(kConstexpr);
+
+    fcp::PolicyTimeoutQueue<Job, fcp::NullLockPolicy, 8> q;
+    Job a(1);
+    Job *out = nullptr;
+    // Blocking waits have nobody to wait for and return at once
+    auto const start = std::chrono::steady_clock::now();
+    EXPECT_EQ(q.pop(out, 100000), Status::Empty);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+    EXPECT_EQ(q.push(a), Status::Ok);
+    EXPECT_EQ(q.pop(out, -1), Status::Ok);
+    EXPECT_EQ(out, &a);
+}
+
+template <typename TPolicy> class LockPolicyTest : public ::testing::Test
+{
+};
+
+// The last one is the fallback SpinningLockPolicy of platforms without futexes
+using CondVarSpinLockPolicy =
+    fcp::LockPolicy<fcp::SpinLock, fcp::LockableTrait<fcp::SpinLock>, std::condition_variable_any,
+                    fcp::CondVarSemaphoreTrait<fcp::LockableTrait<fcp::SpinLock>>>;
+using Policies = ::testing::Types<fcp::StdLockPolicy, fcp::SpinLockPolicy, fcp::TicketLockPolicy,
+                                  fcp::SpinningLockPolicy<std::mutex>, CondVarSpinLockPolicy>;
+TYPED_TEST_SUITE(LockPolicyTest, Policies);
+
+TYPED_TEST(LockPolicyTest, PopTimesOut)
+{
+    fcp::PolicyTimeoutQueue<Job, TypeParam, 8> q;
+    Job *out = nullptr;
+    auto const start = std::chrono::steady_clock::now();
+    EXPECT_EQ(q.pop(out, 2000), Status::Empty);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::microseconds(2000));
+    EXPECT_EQ(q.pop(out), Status::Empty);
+}
+
+TYPED_TEST(LockPolicyTest, ProducersAndBlockedConsumers)
+{
+    constexpr std::size_t kJobs = 64;
+    fcp::PolicyTimeoutQueue<Job, TypeParam, kJobs> q;
+    std::vector<Job> jobs;
+    for (uint16_t i = 0; i < kJobs; ++i)
+    {
+        jobs.emplace_back(i);
+    }
+
+    std::atomic<std::size_t> popped{0};
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 3; ++c)
+    {
+        consumers.emplace_back([&] {
+            Job *out = nullptr;
+            while (q.pop(out, 200000) == Status::Ok)
+            {
+                popped.fetch_add(1);
+            }
+        });
+    }
+
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p < 2; ++p)
+    {
+        producers.emplace_back([&, p] {
+            for (std::size_t i = p; i < kJobs; i += 2)
+            {
+                EXPECT_EQ(q.push(jobs[i]), Status::Ok);
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (auto &t : producers)
+    {
+        t.join();
+    }
+    for (auto &t : consumers)
+    {
+        t.join();
+    }
+    EXPECT_EQ(popped.load(), kJobs);
+    EXPECT_TRUE(q.empty());
+}
+
+} // namespace
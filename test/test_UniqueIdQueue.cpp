@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <gtest/gtest.h>
 #include <limits>
+#include <memory>
+#include <span>
 #include <vector>
 
 using namespace fcp;
@@ -26,6 +28,16 @@ struct TestItem
 constexpr std::size_t kCapacity = 4;
 
 using QueueT = UniqueIdQueue<TestItem, kCapacity>;
+using SplitQueueT = UniqueIdQueue<TestItem, kCapacity, NodeLayout::Split>;
+
+static_assert(std::is_same_v<LinkIndex<254>, uint8_t>);
+static_assert(std::is_same_v<LinkIndex<255>, uint8_t>);
+static_assert(std::is_same_v<LinkIndex<256>, uint16_t>);
+static_assert(std::is_same_v<LinkIndex<4096>, uint16_t>);
+static_assert(std::is_same_v<LinkIndex<65535>, uint16_t>);
+static_assert(std::is_same_v<LinkIndex<65536>, uint32_t>);
+static_assert(sizeof(UniqueIdQueue<TestItem, 4096, NodeLayout::Split>) <
+              sizeof(UniqueIdQueue<TestItem, 4096, NodeLayout::Interleaved>));
 
 TEST(UniqueIdQueueTest, PushPopFrontBasic)
 {
@@ -97,12 +109,12 @@ TEST(UniqueIdQueueTest, PushFull)
     TestItem another(1); // duplicate id
     EXPECT_EQ(q.push(another), Queue::Status::Duplicate);
 
-    TestItem newItem(0); // duplicate id
-    EXPECT_EQ(q.push(newItem), Queue::Status::Duplicate);
+    TestItem newItem(0); // id 0 was popped, so it can be queued again
+    EXPECT_EQ(q.push(newItem), Queue::Status::Ok);
 
     // Try to push when full with a new id (but out of range)
     TestItem outOfRange(kCapacity + 1);
-    EXPECT_EQ(q.push(outOfRange), Queue::Status::InvalidId);
+    EXPECT_EQ(q.push(outOfRange), Queue::Status::Full);
 }
 
 TEST(UniqueIdQueueTest, RemoveByObjectAndId)
@@ -239,4 +251,315 @@ TEST(UniqueIdQueueTest, RemoveHeadAndTail)
     EXPECT_EQ(out, &b);
 }
 
-} // namespace
\ No newline at end of file
+TEST(UniqueIdQueueTest, SplitLayoutOrderAndRemove)
+{
+    SplitQueueT q(kCapacity);
+    TestItem a(0), b(1), c(2), d(3);
+    EXPECT_EQ(q.push(a), Queue::Status::Ok);
+    EXPECT_EQ(q.push(b), Queue::Status::Ok);
+    EXPECT_EQ(q.push(c), Queue::Status::Ok);
+    EXPECT_EQ(q.push(d), Queue::Status::Ok);
+    EXPECT_TRUE(q.full());
+    EXPECT_EQ(q.push(a), Queue::Status::Full);
+
+    EXPECT_EQ(q.remove(c), Queue::Status::Ok);
+    EXPECT_EQ(q.push(b), Queue::Status::Duplicate);
+    EXPECT_EQ(q.remove(0), Queue::Status::Ok);
+
+    TestItem *out = nullptr;
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &b);
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &d);
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.remove(d), Queue::Status::Empty);
+}
+
+TEST(UniqueIdQueueTest, PushPopBatch)
+{
+    QueueT q(kCapacity);
+    TestItem a(0), b(1), c(2), d(3);
+    std::array<TestItem *, 4> in{&a, &b, &b, &c};
+    std::array<TestItem *, 4> out{};
+
+    // Stops at the duplicate
+    EXPECT_EQ(q.push_n(in), 2u);
+    EXPECT_EQ(q.size(), 2u);
+
+    std::array<TestItem *, 3> rest{&c, &d, &a};
+    EXPECT_EQ(q.push_n(rest), 2u);
+    EXPECT_TRUE(q.full());
+
+    EXPECT_EQ(q.pop_n(std::span<TestItem *>(out).first(3)), 3u);
+    EXPECT_EQ(out[0], &a);
+    EXPECT_EQ(out[1], &b);
+    EXPECT_EQ(out[2], &c);
+
+    EXPECT_EQ(q.pop_n(out), 1u);
+    EXPECT_EQ(out[0], &d);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(UniqueIdQueueTest, ForEachDrainRemoveIf)
+{
+    QueueT q(kCapacity);
+    TestItem a(0), b(1), c(2), d(3);
+    for (auto *item : {&c, &a, &d, &b})
+    {
+        EXPECT_EQ(q.push(*item), Queue::Status::Ok);
+    }
+
+    std::vector<uint16_t> seen;
+    q.for_each([&](TestItem &item) { seen.push_back(item.GetId()); });
+    EXPECT_EQ(seen, (std::vector<uint16_t>{2, 0, 3, 1}));
+    EXPECT_EQ(q.size(), 4u);
+
+    // Drop the even IDs, the rest keep their order
+    EXPECT_EQ(q.remove_if([](TestItem const &item) { return item.GetId() % 2 == 0; }), 2u);
+    EXPECT_EQ(q.size(), 2u);
+    EXPECT_EQ(q.remove(c), Queue::Status::NotFound);
+
+    seen.clear();
+    EXPECT_EQ(q.drain([&](TestItem &item) { seen.push_back(item.GetId()); }), 2u);
+    EXPECT_EQ(seen, (std::vector<uint16_t>{3, 1}));
+    EXPECT_TRUE(q.empty());
+
+    // Drained nodes are free again
+    EXPECT_EQ(q.push(b), Queue::Status::Ok);
+    EXPECT_EQ(q.push(d), Queue::Status::Ok);
+    TestItem *out = nullptr;
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &b);
+    EXPECT_EQ(q.drain([](TestItem &) {}), 1u);
+    EXPECT_EQ(q.drain([](TestItem &) {}), 0u);
+}
+
+TEST(UniqueIdQueueTest, ClearInvalidatesAllNodes)
+{
+    QueueT q(kCapacity);
+    TestItem a(0), b(1), c(2);
+    EXPECT_EQ(q.push(a), Queue::Status::Ok);
+    EXPECT_EQ(q.push(b), Queue::Status::Ok);
+
+    q.clear();
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.remove(a), Queue::Status::Empty);
+    EXPECT_EQ(q.remove(uint16_t(1)), Queue::Status::NotFound);
+
+    // Stale nodes are free: re-pushing is not a duplicate and the old links are not followed
+    EXPECT_EQ(q.push(b), Queue::Status::Ok);
+    EXPECT_EQ(q.push(c), Queue::Status::Ok);
+    EXPECT_EQ(q.push(a), Queue::Status::Ok);
+    EXPECT_EQ(q.push(b), Queue::Status::Duplicate);
+    EXPECT_EQ(q.remove(c), Queue::Status::Ok);
+    TestItem *out = nullptr;
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &b);
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &a);
+}
+
+TEST(UniqueIdQueueTest, ClearSurvivesEpochWrap)
+{
+    SplitQueueT q(kCapacity);
+    TestItem a(0), b(1);
+    // Node 0 is stamped with the first epoch, which comes round again after the wrap
+    EXPECT_EQ(q.push(a), Queue::Status::Ok);
+    for (std::size_t i = 0; i < std::numeric_limits<Epoch>::max(); ++i)
+    {
+        q.clear();
+    }
+
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.remove(a), Queue::Status::Empty);
+    EXPECT_EQ(q.push(b), Queue::Status::Ok);
+    EXPECT_EQ(q.push(a), Queue::Status::Ok);
+    EXPECT_EQ(q.size(), 2u);
+    TestItem *out = nullptr;
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &b);
+}
+
+// Element without GetId(), indexed through an external 32-bit key
+struct Connection
+{
+    uint32_t slot;
+};
+
+struct SlotKey
+{
+    static constexpr uint32_t key(Connection const &c)
+    {
+        return c.slot;
+    }
+};
+
+TEST(UniqueIdQueueTest, CustomKeyBeyondUint16)
+{
+    constexpr std::size_t kWide = 70000;
+    using WideQueue = UniqueIdQueue<Connection, kWide, NodeLayout::Interleaved, SlotKey>;
+    static_assert(std::is_same_v<LinkIndex<kWide>, uint32_t>);
+
+    auto q = std::make_unique<WideQueue>(kWide);
+    Connection a{69999}, b{65535}, c{7}, alias{69999}, bad{70000};
+
+    EXPECT_EQ(q->push(a), Queue::Status::Ok);
+    EXPECT_EQ(q->push(b), Queue::Status::Ok);
+    EXPECT_EQ(q->push(c), Queue::Status::Ok);
+    EXPECT_EQ(q->push(alias), Queue::Status::Duplicate);
+    EXPECT_EQ(q->push(bad), Queue::Status::InvalidId);
+
+    EXPECT_EQ(q->remove(uint32_t{65535}), Queue::Status::Ok);
+    Connection *out = nullptr;
+    EXPECT_EQ(q->pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &a);
+    EXPECT_EQ(q->pop(out), Queue::Status::Ok);
+    EXPECT_EQ(out, &c);
+    EXPECT_TRUE(q->empty());
+}
+
+TEST(UniqueIdQueueTest, StatsPolicy)
+{
+    static_assert(sizeof(UniqueIdQueue<TestItem, kCapacity, NodeLayout::Interleaved, GetIdKey, NoStats>) ==
+                  sizeof(QueueT));
+
+    UniqueIdQueue<TestItem, kCapacity, NodeLayout::Interleaved, GetIdKey, QueueStats<>> q(kCapacity);
+    std::vector<TestItem> items;
+    for (uint16_t i = 0; i < kCapacity; ++i)
+    {
+        items.emplace_back(i);
+    }
+    TestItem *out = nullptr;
+    EXPECT_EQ(q.pop(out), Queue::Status::Empty);
+    EXPECT_EQ(q.remove(items[0]), Queue::Status::Empty);
+    for (auto &item : items)
+    {
+        EXPECT_EQ(q.push(item), Queue::Status::Ok);
+    }
+    EXPECT_EQ(q.push(items[0]), Queue::Status::Full);
+    EXPECT_EQ(q.pop(out), Queue::Status::Ok);
+    EXPECT_EQ(q.push(items[1]), Queue::Status::Duplicate);
+    EXPECT_EQ(q.remove(items[2]), Queue::Status::Ok);
+    EXPECT_EQ(q.remove_if([](TestItem const &c) { return c.GetId() == 3; }), 1u);
+    q.clear();
+
+    auto const s = q.stats().snapshot();
+    EXPECT_EQ(s.pushes, 4u);
+    EXPECT_EQ(s.pops, 1u);
+    EXPECT_EQ(s.removes, 3u);
+    EXPECT_EQ(s.full, 1u);
+    EXPECT_EQ(s.duplicate, 1u);
+    EXPECT_EQ(s.empty, 2u);
+    EXPECT_EQ(s.high_water, kCapacity);
+}
+
+TEST(UniqueIdQueueTest, CapacityIsClamped)
+{
+    QueueT q(1000);
+    std::vector<TestItem> items;
+    for (uint16_t i = 0; i < 6; ++i)
+    {
+        items.emplace_back(i);
+    }
+    for (uint16_t i = 0; i < kCapacity; ++i)
+    {
+        EXPECT_EQ(q.push(items[i]), Queue::Status::Ok);
+    }
+    EXPECT_TRUE(q.full());
+    EXPECT_EQ(q.push(items[kCapacity]), Queue::Status::Full);
+}
+
+// Compile-time checks: every operation is usable in a constant expression
+
+struct StaticTask
+{
+    uint16_t id;
+    constexpr uint16_t GetId() const
+    {
+        return id;
+    }
+};
+
+template <NodeLayout Layout> constexpr bool ConstexprPushPopRemove()
+{
+    StaticTask a{0}, b{1}, c{2}, d{3};
+    UniqueIdQueue<StaticTask, kCapacity, Layout> q(kCapacity);
+    StaticTask *out = nullptr;
+
+    bool ok = q.empty() && q.pop(out) == Queue::Status::Empty;
+    ok = ok && q.push(a) == Queue::Status::Ok && q.push(b) == Queue::Status::Ok && q.push(c) == Queue::Status::Ok;
+    ok = ok && q.push(b) == Queue::Status::Duplicate && q.size() == 3;
+    ok = ok && q.remove(b) == Queue::Status::Ok && q.remove(b) == Queue::Status::NotFound;
+    ok = ok && q.push(d) == Queue::Status::Ok && q.push(b) == Queue::Status::Ok && q.full();
+    ok = ok && q.front(out) == Queue::Status::Ok && out == &a;
+
+    // FIFO order after the removal: a, c, d, b
+    std::array<StaticTask *, 4> batch{};
+    ok = ok && q.pop(out) == Queue::Status::Ok && out == &a;
+    ok = ok && q.pop_n(std::span<StaticTask *>(batch)) == 3;
+    ok = ok && batch[0] == &c && batch[1] == &d && batch[2] == &b && q.empty();
+    return ok;
+}
+static_assert(ConstexprPushPopRemove<NodeLayout::Interleaved>());
+static_assert(ConstexprPushPopRemove<NodeLayout::Split>());
+
+constexpr bool ConstexprBulkOperations()
+{
+    StaticTask a{0}, b{1}, c{2}, d{3};
+    std::array<StaticTask *, 4> all{&a, &b, &c, &d};
+    UniqueIdQueue<StaticTask, kCapacity> q(kCapacity);
+
+    bool ok = q.push_n(std::span<StaticTask *const>(all)) == 4;
+    std::size_t sum = 0;
+    q.for_each([&](StaticTask const &t) { sum += t.GetId(); });
+    ok = ok && sum == 6;
+    ok = ok && q.remove_if([](StaticTask const &t) { return t.GetId() % 2 == 1; }) == 2 && q.size() == 2;
+
+    uint16_t order = 0;
+    ok = ok && q.drain([&](StaticTask const &t) { order = static_cast<uint16_t>(order * 10 + t.GetId() + 1); }) == 2;
+    ok = ok && order == 13 && q.empty();
+
+    // clear() advances the epoch instead of walking the nodes; the IDs are free again afterwards
+    ok = ok && q.push_n(std::span<StaticTask *const>(all)) == 4;
+    q.clear();
+    ok = ok && q.empty() && q.push(c) == Queue::Status::Ok && q.size() == 1;
+    return ok;
+}
+static_assert(ConstexprBulkOperations());
+
+// A boot-time schedule built entirely by the compiler from a table of const elements
+constexpr std::array<StaticTask, 4> kStaticTasks{{{0}, {1}, {2}, {3}}};
+using StaticScheduleT = UniqueIdQueue<StaticTask const, kCapacity>;
+
+constexpr StaticScheduleT kBootSchedule = [] {
+    StaticScheduleT q(kCapacity);
+    q.push(kStaticTasks[2]);
+    q.push(kStaticTasks[0]);
+    q.push(kStaticTasks[3]);
+    return q;
+}();
+
+static_assert(kBootSchedule.size() == 3);
+static_assert([] {
+    StaticTask const *out = nullptr;
+    return kBootSchedule.front(out) == Queue::Status::Ok && out == &kStaticTasks[2];
+}());
+
+TEST(UniqueIdQueueTest, CopiesCompileTimeSchedule)
+{
+    // The schedule is constant-initialized; copying it is all the startup work there is
+    StaticScheduleT q = kBootSchedule;
+    StaticTask const *out = nullptr;
+
+    EXPECT_EQ(q.push(kStaticTasks[0]), Queue::Status::Duplicate);
+    EXPECT_EQ(q.push(kStaticTasks[1]), Queue::Status::Ok);
+    for (uint16_t id : {2, 0, 3, 1})
+    {
+        ASSERT_EQ(q.pop(out), Queue::Status::Ok);
+        EXPECT_EQ(out->GetId(), id);
+    }
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(kBootSchedule.size(), 3u);
+}
+
+} // namespace
@@ -0,0 +1,120 @@
+#include "ContainerQueue/WorkStealingDeque.hpp"
+#include <array>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using fcp::WorkStealingDeque;
+using Status = fcp::Queue::Status;
+
+TEST(WorkStealingDequeTest, OwnerPopsLifoThievesStealFifo)
+{
+    WorkStealingDeque<int, 4> q;
+    int out = 0;
+
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.pop(out), Status::Empty);
+    EXPECT_EQ(q.steal(out), Status::Empty);
+
+    for (int i = 1; i <= 4; ++i)
+    {
+        EXPECT_EQ(q.push(i), Status::Ok);
+    }
+    EXPECT_TRUE(q.full());
+    EXPECT_EQ(q.push(5), Status::Full);
+
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(out, 4);
+    EXPECT_EQ(q.steal(out), Status::Ok);
+    EXPECT_EQ(out, 1);
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(out, 3);
+    EXPECT_EQ(q.steal(out), Status::Ok);
+    EXPECT_EQ(out, 2);
+
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.pop(out), Status::Empty);
+    EXPECT_EQ(q.steal(out), Status::Empty);
+    EXPECT_EQ(q.size(), 0u);
+}
+
+TEST(WorkStealingDequeTest, WrapAround)
+{
+    WorkStealingDeque<int, 3> q;
+    int out = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(q.push(i), Status::Ok);
+        EXPECT_EQ(q.push(i + 100), Status::Ok);
+        EXPECT_EQ(q.steal(out), Status::Ok);
+        EXPECT_EQ(out, i);
+        EXPECT_EQ(q.pop(out), Status::Ok);
+        EXPECT_EQ(out, i + 100);
+        EXPECT_TRUE(q.empty());
+    }
+}
+
+// The owner pushes and pops while thieves steal; every element must be taken exactly once
+TEST(WorkStealingDequeTest, OwnerAndThievesTakeEachElementOnce)
+{
+    constexpr int kCount = 50000;
+    constexpr int kThieves = 3;
+    WorkStealingDeque<int, 64> q;
+    std::vector<std::atomic<int>> taken(kCount);
+    std::atomic<int> total{0};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < kThieves; ++t)
+    {
+        thieves.emplace_back([&] {
+            int out = 0;
+            while (total.load() < kCount)
+            {
+                if (q.steal(out) == Status::Ok)
+                {
+                    taken[out].fetch_add(1);
+                    total.fetch_add(1);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    int out = 0;
+    for (int i = 0; i < kCount; ++i)
+    {
+        while (q.push(i) != Status::Ok)
+        {
+            if (q.pop(out) == Status::Ok)
+            {
+                taken[out].fetch_add(1);
+                total.fetch_add(1);
+            }
+        }
+        // Keep the deque short so the owner and the thieves keep racing for the last element
+        if (i % 2 == 0 && q.pop(out) == Status::Ok)
+        {
+            taken[out].fetch_add(1);
+            total.fetch_add(1);
+        }
+    }
+    while (q.pop(out) == Status::Ok)
+    {
+        taken[out].fetch_add(1);
+        total.fetch_add(1);
+    }
+    for (auto &t : thieves)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(total.load(), kCount);
+    for (auto const &count : taken)
+    {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
@@ -1,8 +1,13 @@
 #include "ContainerQueue/TimeoutQueue.hpp"
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <coroutine>
 #include <gtest/gtest.h>
 #include <memory>
 #include <mutex>
+#include <span>
+#include <thread>
 #include <vector>
 
 #define UNUSED(x) (void)(x)
@@ -56,32 +61,69 @@ template <> struct SemaphoreTraits<std::condition_variable>
     template <typename Predicate>
     static bool wait(std::condition_variable &cv, std::mutex &mtx, Predicate pred, long timeout_us = 0)
     {
-        std::unique_lock<std::mutex> lock(mtx);
+        // Entered with the mutex held; the queue unlocks it again, exactly once
+        std::unique_lock<std::mutex> lock(mtx, std::adopt_lock);
+        bool ok = true;
         if (timeout_us < 0)
         {
             cv.wait(lock, pred);
-            return true;
         }
         else if (timeout_us == 0)
         {
             // Non-blocking: just check the predicate
-            return pred();
+            ok = pred();
         }
         else
         {
-            return cv.wait_for(lock, std::chrono::microseconds(timeout_us), pred);
+            ok = cv.wait_for(lock, std::chrono::microseconds(timeout_us), pred);
         }
+        lock.release();
+        return ok;
     }
 
     static void notify(std::condition_variable &cv)
     {
         cv.notify_one();
     }
+
+    static void notify_all(std::condition_variable &cv)
+    {
+        cv.notify_all();
+    }
+};
+
+// Counts lock acquisitions to check which operations stay off the mutex
+struct CountingMutexTraits : MutexTraits<std::mutex>
+{
+    static inline std::atomic<int> locks{0};
+
+    static void lock(std::mutex &mtx)
+    {
+        ++locks;
+        mtx.lock();
+    }
+};
+
+// Counts semaphore signals to check that producers skip the wakeup when nobody waits
+struct CountingSemaphoreTraits : SemaphoreTraits<std::condition_variable>
+{
+    static inline std::atomic<int> notifications{0};
+
+    static void notify(std::condition_variable &cv)
+    {
+        ++notifications;
+        cv.notify_one();
+    }
 };
 
 using Container = MockContainer;
 using TimeoutQueue = fcp::TimeoutQueue<MockContainer, std::mutex, std::condition_variable, MutexTraits<std::mutex>,
                                        SemaphoreTraits<std::condition_variable>>;
+using SmallTimeoutQueue = fcp::TimeoutQueue<MockContainer, std::mutex, std::condition_variable,
+                                            MutexTraits<std::mutex>, SemaphoreTraits<std::condition_variable>, 16>;
+using DeadlineTimeoutQueue =
+    fcp::TimeoutQueue<MockContainer, std::mutex, std::condition_variable, MutexTraits<std::mutex>,
+                      SemaphoreTraits<std::condition_variable>, 16, fcp::TimerWheel<16>>;
 using Status = fcp::Queue::Status;
 
 class TimeoutQueueTest : public ::testing::Test
@@ -122,6 +164,108 @@ TEST(TimeoutQueueTests, ConstructorWithDifferentCapacities)
     EXPECT_FALSE(large_queue.full());
 }
 
+// Test that node storage follows the compile-time Capacity
+TEST(TimeoutQueueTests, CompileTimeCapacity)
+{
+    static_assert(sizeof(SmallTimeoutQueue) < sizeof(TimeoutQueue) / 1000);
+
+    SmallTimeoutQueue queue;
+    std::vector<Container> containers;
+    for (uint16_t i = 0; i < 16; ++i)
+    {
+        containers.emplace_back(i);
+    }
+    for (auto &c : containers)
+    {
+        EXPECT_EQ(queue.push(c), Status::Ok);
+    }
+    EXPECT_TRUE(queue.full());
+
+    Container *out = nullptr;
+    EXPECT_EQ(queue.pop(out), Status::Ok);
+    EXPECT_EQ(out->GetId(), 0);
+
+    Container c_invalid(16);
+    EXPECT_EQ(queue.push(c_invalid), Status::InvalidId);
+}
+
+// Test that a runtime capacity above the compile-time Capacity is clamped
+// Test that the hot field groups are cache-line aligned, which makes the queue itself over-aligned
+TEST(TimeoutQueueTests, CacheLineAlignedLayout)
+{
+    static_assert(alignof(SmallTimeoutQueue) == fcp::kCacheLineSize);
+    static_assert(sizeof(SmallTimeoutQueue) % fcp::kCacheLineSize == 0);
+
+    // Heap allocation honours the alignment
+    auto q = std::make_unique<SmallTimeoutQueue>();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(q.get()) % fcp::kCacheLineSize, 0u);
+}
+
+TEST(TimeoutQueueTests, RuntimeCapacityClamped)
+{
+    SmallTimeoutQueue queue(1000);
+    Container c15(15);
+    Container c16(16);
+    EXPECT_EQ(queue.push(c15), Status::Ok);
+    EXPECT_EQ(queue.push(c16), Status::InvalidId);
+}
+
+// Test per-element deadlines
+TEST(TimeoutQueueTests, DeadlineExpiry)
+{
+    DeadlineTimeoutQueue queue;
+    Container c1(1);
+    Container c2(2);
+    Container c3(3);
+    Container c4(4);
+
+    EXPECT_EQ(queue.push(c1, fcp::Deadline{100}), Status::Ok);
+    EXPECT_EQ(queue.push(c2, fcp::Deadline{50}), Status::Ok);
+    EXPECT_EQ(queue.push(c3), Status::Ok); // never expires
+    EXPECT_EQ(queue.push(c4, fcp::Deadline{70}), Status::Ok);
+    EXPECT_EQ(queue.push(c4, fcp::Deadline{10}), Status::Duplicate);
+
+    std::vector<uint16_t> expired;
+    auto collect = [&](Container &c) { expired.push_back(c.GetId()); };
+
+    EXPECT_EQ(queue.expire(49, collect), 0u);
+    EXPECT_EQ(queue.expire(70, collect), 2u);
+    EXPECT_EQ(expired, (std::vector<uint16_t>{2, 4}));
+    EXPECT_EQ(queue.size(), 2);
+
+    // FIFO order of the remaining elements is kept
+    Container *out = nullptr;
+    EXPECT_EQ(queue.front(out), Status::Ok);
+    EXPECT_EQ(out->GetId(), 1);
+
+    EXPECT_EQ(queue.pop_expired(99, out), Status::Empty);
+    EXPECT_EQ(queue.pop_expired(100, out), Status::Ok);
+    EXPECT_EQ(out->GetId(), 1);
+    EXPECT_EQ(queue.pop_expired(1000000, out), Status::Empty);
+    EXPECT_EQ(queue.size(), 1);
+}
+
+// Test that leaving the queue cancels the deadline
+TEST(TimeoutQueueTests, DeadlineCancelledByRemoveAndPop)
+{
+    DeadlineTimeoutQueue queue;
+    Container c1(1);
+    Container c2(2);
+    Container *out = nullptr;
+
+    EXPECT_EQ(queue.push(c1, fcp::Deadline{10}), Status::Ok);
+    EXPECT_EQ(queue.push(c2, fcp::Deadline{10}), Status::Ok);
+    EXPECT_EQ(queue.remove(c1), Status::Ok);
+    EXPECT_EQ(queue.pop(out), Status::Ok);
+    EXPECT_EQ(out->GetId(), 2);
+
+    // Re-queued without a deadline: the old timers must not fire
+    EXPECT_EQ(queue.push(c1), Status::Ok);
+    EXPECT_EQ(queue.push(c2), Status::Ok);
+    EXPECT_EQ(queue.expire(1000, [](Container &) { FAIL(); }), 0u);
+    EXPECT_EQ(queue.size(), 2);
+}
+
 // Test basic push operation
 TEST_F(TimeoutQueueTest, BasicPush)
 {
@@ -295,6 +439,609 @@ TEST_F(TimeoutQueueTest, FIFOOrder)
     EXPECT_TRUE(queue->empty());
 }
 
+// Test batch push and pop
+TEST_F(TimeoutQueueTest, PushPopBatch)
+{
+    Container c1(1);
+    Container c2(2);
+    Container c3(3);
+    Container c_invalid(15);
+    std::array<Container *, 4> in{&c1, &c2, &c_invalid, &c3};
+    std::array<Container *, 4> out{};
+
+    EXPECT_EQ(queue->pop_n(out), 0u);
+
+    // Stops at the invalid ID
+    EXPECT_EQ(queue->push_n(in), 2u);
+    EXPECT_EQ(queue->size(), 2);
+    EXPECT_EQ(queue->push_n(std::span<Container *const>(in).subspan(3)), 1u);
+
+    EXPECT_EQ(queue->pop_n(std::span<Container *>(out).first(2)), 2u);
+    EXPECT_EQ(out[0]->GetId(), 1);
+    EXPECT_EQ(out[1]->GetId(), 2);
+
+    EXPECT_EQ(queue->pop_n(out), 1u);
+    EXPECT_EQ(out[0]->GetId(), 3);
+    EXPECT_TRUE(queue->empty());
+}
+
+// Test that a single batch push wakes every blocked consumer
+TEST_F(TimeoutQueueTest, BatchPushWakesAllConsumers)
+{
+    constexpr int num_threads = 4;
+    std::vector<Container> containers;
+    for (uint16_t i = 0; i < num_threads; ++i)
+    {
+        containers.emplace_back(i);
+    }
+    std::vector<Container *> in;
+    for (auto &c : containers)
+    {
+        in.push_back(&c);
+    }
+
+    std::vector<std::thread> threads;
+    std::atomic<int> pop_count{0};
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&]() {
+            Container *out = nullptr;
+            if (queue->pop(out, 2000000) == Status::Ok)
+                ++pop_count;
+        });
+    }
+
+    EXPECT_EQ(queue->push_n(in), in.size());
+    for (auto &th : threads)
+        th.join();
+
+    EXPECT_EQ(pop_count, num_threads);
+    EXPECT_TRUE(queue->empty());
+}
+
+// Test that pushes without a blocked consumer do not signal the semaphore
+TEST(TimeoutQueueTests, NoNotifyWithoutWaiters)
+{
+    using CountingQueue = fcp::TimeoutQueue<MockContainer, std::mutex, std::condition_variable,
+                                            MutexTraits<std::mutex>, CountingSemaphoreTraits, 16>;
+    CountingQueue q;
+    std::vector<Container> containers;
+    for (uint16_t i = 0; i < 4; ++i)
+    {
+        containers.emplace_back(i);
+    }
+
+    CountingSemaphoreTraits::notifications = 0;
+    EXPECT_EQ(q.push(containers[0]), Status::Ok);
+    EXPECT_EQ(q.push(containers[1]), Status::Ok);
+    std::vector<Container *> in{&containers[2], &containers[3]};
+    EXPECT_EQ(q.push_n(in), in.size());
+    EXPECT_EQ(CountingSemaphoreTraits::notifications, 0);
+
+    Container *out = nullptr;
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(q.pop(out), Status::Ok);
+    }
+
+    // A consumer blocked on the empty queue is still woken by the next push
+    std::thread consumer([&]() { EXPECT_EQ(q.pop(out, 2000000), Status::Ok); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(q.push(containers[0]), Status::Ok);
+    consumer.join();
+    EXPECT_TRUE(q.empty());
+}
+
+// Test that a timed push waits for space and reports Timeout when none is freed
+TEST(TimeoutQueueTests, TimedPushBackpressure)
+{
+    SmallTimeoutQueue q(2);
+    Container a(0), b(1), alias(0);
+    EXPECT_EQ(q.push(a, 1000), Status::Ok);
+    EXPECT_EQ(q.push(b), Status::Ok);
+
+    EXPECT_EQ(q.push(alias, 0), Status::Full);
+    EXPECT_EQ(q.push(alias, 1000), Status::Timeout);
+    EXPECT_STREQ(fcp::Queue::to_string(Status::Timeout), "Timeout");
+
+    // A pop on another thread frees the slot of ID 0 and wakes the blocked producer
+    Container *out = nullptr;
+    std::thread consumer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_EQ(q.pop(out), Status::Ok);
+    });
+    EXPECT_EQ(q.push(alias, 2000000), Status::Ok);
+    consumer.join();
+    EXPECT_EQ(out, &a);
+
+    // Space freed by another ID leaves the waiting element a duplicate
+    std::thread remover([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_EQ(q.remove(b), Status::Ok);
+    });
+    EXPECT_EQ(q.push(a, 2000000), Status::Duplicate);
+    remover.join();
+    EXPECT_EQ(q.size(), 1u);
+}
+
+// Test that a spinning consumer picks up an element pushed while it polls, and that spinning can be retuned
+TEST(TimeoutQueueTests, SpinThenBlock)
+{
+    SmallTimeoutQueue q(16, 1000);
+    EXPECT_EQ(q.spin_count(), 1000u);
+    Container c(3);
+
+    Container *out = nullptr;
+    std::thread consumer([&]() { EXPECT_EQ(q.pop(out, 2000000), Status::Ok); });
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+    EXPECT_EQ(q.push(c), Status::Ok);
+    consumer.join();
+    EXPECT_EQ(out, &c);
+
+    // The spin phase never applies to non-blocking pops
+    EXPECT_EQ(q.pop(out), Status::Empty);
+
+    // Spin exhausted: the consumer falls back to the blocking wait
+    q.set_spin_count(1);
+    EXPECT_EQ(q.spin_count(), 1u);
+    std::thread blocked([&]() { EXPECT_EQ(q.pop(out, 2000000), Status::Ok); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(q.push(c), Status::Ok);
+    blocked.join();
+    EXPECT_TRUE(q.empty());
+}
+
+// Test that size(), empty() and full() are answered without taking the lock
+TEST(TimeoutQueueTests, LockFreeObservers)
+{
+    using CountingQueue = fcp::TimeoutQueue<MockContainer, std::mutex, std::condition_variable, CountingMutexTraits,
+                                            SemaphoreTraits<std::condition_variable>, 2>;
+    CountingQueue q;
+    Container a(0), b(1);
+    EXPECT_EQ(q.push(a), Status::Ok);
+    EXPECT_EQ(q.push(b), Status::Ok);
+
+    CountingMutexTraits::locks = 0;
+    EXPECT_EQ(q.size(), 2u);
+    EXPECT_TRUE(q.full());
+    EXPECT_FALSE(q.empty());
+    EXPECT_EQ(CountingMutexTraits::locks, 0);
+
+    // The mirror follows every mutation
+    EXPECT_EQ(q.remove(a), Status::Ok);
+    EXPECT_EQ(q.size(), 1u);
+    EXPECT_FALSE(q.full());
+    Container *out = nullptr;
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_TRUE(q.empty());
+}
+
+// Test that the statistics policy counts every outcome and times lock holds and blocking pops
+TEST(TimeoutQueueTests, StatsPolicy)
+{
+    static_assert(sizeof(fcp::TimeoutQueue<MockContainer, std::mutex, std::condition_variable, MutexTraits<std::mutex>,
+                                           SemaphoreTraits<std::condition_variable>, 16, fcp::NoTimer, fcp::GetIdKey,
+                                           fcp::NoStats>) == sizeof(SmallTimeoutQueue));
+
+    using StatsQueue = fcp::TimeoutQueue<MockContainer, std::mutex, std::condition_variable, MutexTraits<std::mutex>,
+                                         SemaphoreTraits<std::condition_variable>, 3, fcp::NoTimer, fcp::GetIdKey,
+                                         fcp::QueueStats<true>>;
+    StatsQueue q;
+    Container a(0), b(1), c(2);
+    Container *out = nullptr;
+
+    EXPECT_EQ(q.pop(out, 1000), Status::Empty);
+    EXPECT_EQ(q.push(a), Status::Ok);
+    EXPECT_EQ(q.push(a), Status::Duplicate);
+    EXPECT_EQ(q.push(b), Status::Ok);
+    EXPECT_EQ(q.push(c), Status::Ok);
+    EXPECT_EQ(q.push(a), Status::Full);
+    EXPECT_EQ(q.push(a, 0), Status::Full);
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(q.remove(b), Status::Ok);
+    q.clear();
+    EXPECT_EQ(q.remove(c), Status::Empty);
+
+    // A consumer blocked in pop() reports its wait once the producer hands it an element
+    std::thread consumer([&] { EXPECT_EQ(q.pop(out, -1), Status::Ok); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(q.push(a), Status::Ok);
+    consumer.join();
+
+    auto const s = q.stats().snapshot();
+    EXPECT_EQ(s.pushes, 4u);
+    EXPECT_EQ(s.pops, 2u);
+    EXPECT_EQ(s.removes, 2u);
+    EXPECT_EQ(s.full, 2u);
+    EXPECT_EQ(s.duplicate, 1u);
+    EXPECT_EQ(s.empty, 2u);
+    EXPECT_EQ(s.high_water, 3u);
+
+    std::size_t waits = 0;
+    for (auto n : s.wait_ns)
+    {
+        waits += n;
+    }
+    EXPECT_EQ(waits, 2u);
+    // The blocked pop waited for at least a millisecond, i.e. into bucket 20 or above
+    std::size_t long_waits = 0;
+    for (std::size_t i = fcp::QueueStats<true>::bucket(1000000); i < s.wait_ns.size(); ++i)
+    {
+        long_waits += s.wait_ns[i];
+    }
+    EXPECT_GE(long_waits, 1u);
+
+    std::size_t holds = 0;
+    for (auto n : s.lock_hold_ns)
+    {
+        holds += n;
+    }
+    EXPECT_GT(holds, 0u);
+
+    // The default policy only counts and leaves the histograms empty
+    using CountingQueue = fcp::TimeoutQueue<MockContainer, std::mutex, std::condition_variable, MutexTraits<std::mutex>,
+                                            SemaphoreTraits<std::condition_variable>, 3, fcp::NoTimer, fcp::GetIdKey,
+                                            fcp::QueueStats<>>;
+    static_assert(sizeof(fcp::QueueStats<>) < sizeof(fcp::QueueStats<true>));
+    CountingQueue counting;
+    EXPECT_EQ(counting.pop(out, 1000), Status::Empty);
+    EXPECT_EQ(counting.push(a), Status::Ok);
+    EXPECT_EQ(counting.pop(out), Status::Ok);
+    auto const counted = counting.stats().snapshot();
+    EXPECT_EQ(counted.pushes, 1u);
+    EXPECT_EQ(counted.pops, 1u);
+    EXPECT_EQ(counted.empty, 1u);
+    EXPECT_EQ(counted.lock_hold_ns, decltype(counted.lock_hold_ns){});
+    EXPECT_EQ(counted.wait_ns, decltype(counted.wait_ns){});
+}
+
+// Test that for_each, remove_if and drain walk the list under one lock and keep the queue consistent
+TEST_F(TimeoutQueueTest, ForEachDrainRemoveIf)
+{
+    std::vector<Container> containers;
+    for (uint16_t i = 0; i < 6; ++i)
+    {
+        containers.emplace_back(i);
+    }
+    for (auto &c : containers)
+    {
+        EXPECT_EQ(queue->push(c), Status::Ok);
+    }
+
+    std::vector<uint16_t> seen;
+    queue->for_each([&](Container &c) { seen.push_back(c.GetId()); });
+    EXPECT_EQ(seen, (std::vector<uint16_t>{0, 1, 2, 3, 4, 5}));
+
+    EXPECT_EQ(queue->remove_if([](Container const &c) { return c.GetId() % 3 == 0; }), 2u);
+    EXPECT_EQ(queue->size(), 4u);
+    EXPECT_EQ(queue->remove(containers[3]), Status::NotFound);
+
+    seen.clear();
+    EXPECT_EQ(queue->drain([&](Container &c) { seen.push_back(c.GetId()); }), 4u);
+    EXPECT_EQ(seen, (std::vector<uint16_t>{1, 2, 4, 5}));
+    EXPECT_TRUE(queue->empty());
+
+    Container *out = nullptr;
+    EXPECT_EQ(queue->pop(out), Status::Empty);
+    EXPECT_EQ(queue->push(containers[4]), Status::Ok);
+    EXPECT_EQ(queue->pop(out), Status::Ok);
+    EXPECT_EQ(out, &containers[4]);
+}
+
+// Element without GetId(), indexed through an external 32-bit key
+struct Session
+{
+    uint32_t slot;
+};
+
+struct SessionKey
+{
+    static uint32_t key(Session const &s)
+    {
+        return s.slot;
+    }
+};
+
+// Test a queue over more than 65535 IDs through a custom key trait
+TEST(TimeoutQueueTests, WideCustomKey)
+{
+    constexpr std::size_t kWide = 100000;
+    using WideQueue = fcp::TimeoutQueue<Session, std::mutex, std::condition_variable, MutexTraits<std::mutex>,
+                                        SemaphoreTraits<std::condition_variable>, kWide, fcp::NoTimer, SessionKey>;
+    auto q = std::make_unique<WideQueue>();
+    Session a{99999}, b{70000}, c{1};
+
+    EXPECT_EQ(q->push(a), Status::Ok);
+    EXPECT_EQ(q->push(b), Status::Ok);
+    EXPECT_EQ(q->push(c), Status::Ok);
+    EXPECT_EQ(q->push(b), Status::Duplicate);
+    Session bad{100000};
+    EXPECT_EQ(q->push(bad), Status::InvalidId);
+    EXPECT_EQ(q->size(), 3u);
+
+    EXPECT_EQ(q->remove(b), Status::Ok);
+    Session *out = nullptr;
+    EXPECT_EQ(q->pop(out), Status::Ok);
+    EXPECT_EQ(out, &a);
+    EXPECT_EQ(q->pop(out), Status::Ok);
+    EXPECT_EQ(out, &c);
+    EXPECT_TRUE(q->empty());
+}
+
+// Test that clear() empties the queue and its timers without walking the list
+TEST(TimeoutQueueTests, ClearResetsQueueAndDeadlines)
+{
+    DeadlineTimeoutQueue q;
+    Container a(1), b(2), c(3);
+    EXPECT_EQ(q.push(a, fcp::Deadline{10}), Status::Ok);
+    EXPECT_EQ(q.push(b), Status::Ok);
+    q.clear();
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.remove(a), Status::Empty);
+
+    EXPECT_EQ(q.push(b), Status::Ok);
+    EXPECT_EQ(q.push(b), Status::Duplicate);
+    EXPECT_EQ(q.push(a), Status::Ok);
+    EXPECT_EQ(q.push(c, fcp::Deadline{30}), Status::Ok);
+
+    Container *out = nullptr;
+    // a's old deadline was dropped by clear()
+    EXPECT_EQ(q.pop_expired(20, out), Status::Empty);
+    EXPECT_EQ(q.pop_expired(30, out), Status::Ok);
+    EXPECT_EQ(out, &c);
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(out, &b);
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(out, &a);
+    EXPECT_TRUE(q.empty());
+}
+
+// Minimal eager coroutine for the async tests; the frame is kept until the Task is destroyed
+struct Task
+{
+    struct promise_type
+    {
+        Task get_return_object()
+        {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+        std::suspend_always final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_void()
+        {
+        }
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+    };
+
+    explicit Task(std::coroutine_handle<promise_type> h) : handle(h)
+    {
+    }
+    Task(Task &&other) noexcept : handle(std::exchange(other.handle, {}))
+    {
+    }
+    Task(const Task &) = delete;
+    ~Task()
+    {
+        if (handle)
+        {
+            handle.destroy();
+        }
+    }
+
+    bool done() const
+    {
+        return handle.done();
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+Task AsyncPop(SmallTimeoutQueue &q, Container *&out, Status &status)
+{
+    status = co_await q.async_pop(out);
+}
+
+Task AsyncPopUntil(SmallTimeoutQueue &q, Container *&out, Status &status, uint64_t deadline)
+{
+    status = co_await q.async_pop(out, fcp::Deadline{deadline});
+}
+
+Task AsyncPush(SmallTimeoutQueue &q, Container &c, Status &status)
+{
+    status = co_await q.async_push(c);
+}
+
+using CountingAsyncQueue = fcp::TimeoutQueue<MockContainer, std::mutex, std::condition_variable, CountingMutexTraits,
+                                              SemaphoreTraits<std::condition_variable>, 16>;
+
+Task CountedAsyncPop(CountingAsyncQueue &q, Container *&out, Status &status)
+{
+    status = co_await q.async_pop(out);
+}
+
+Task CountedAsyncPush(CountingAsyncQueue &q, Container &c, Status &status)
+{
+    status = co_await q.async_push(c);
+}
+
+// Test that an awaiter that does not stay suspended releases without another lock round-trip
+TEST(TimeoutQueueTests, AsyncAwaitersLockOnce)
+{
+    CountingAsyncQueue q;
+    Container a(1), b(2);
+    Container *out = nullptr;
+    Status status = Status::Empty;
+
+    CountingMutexTraits::locks = 0;
+    auto pusher = CountedAsyncPush(q, a, status);
+    EXPECT_TRUE(pusher.done());
+    EXPECT_EQ(status, Status::Ok);
+    EXPECT_EQ(CountingMutexTraits::locks, 1);
+
+    CountingMutexTraits::locks = 0;
+    auto ready = CountedAsyncPop(q, out, status);
+    EXPECT_TRUE(ready.done());
+    EXPECT_EQ(status, Status::Ok);
+    EXPECT_EQ(out, &a);
+    EXPECT_EQ(CountingMutexTraits::locks, 1);
+
+    // Suspending and being resumed by a push: one lock each, none when the resumed awaiter goes away
+    CountingMutexTraits::locks = 0;
+    auto parked = CountedAsyncPop(q, out, status);
+    EXPECT_FALSE(parked.done());
+    EXPECT_EQ(q.push(b), Status::Ok);
+    EXPECT_TRUE(parked.done());
+    EXPECT_EQ(out, &b);
+    EXPECT_EQ(CountingMutexTraits::locks, 2);
+}
+
+// Test that suspended coroutines get pushed elements handed over directly, in FIFO order, on the pushing thread
+TEST(TimeoutQueueTests, AsyncPopHandOff)
+{
+    SmallTimeoutQueue q;
+    Container a(1), b(2);
+    Container *out = nullptr;
+    Status status = Status::Empty;
+
+    // An element that is already queued is taken without suspending
+    EXPECT_EQ(q.push(a), Status::Ok);
+    auto ready = AsyncPop(q, out, status);
+    EXPECT_TRUE(ready.done());
+    EXPECT_EQ(status, Status::Ok);
+    EXPECT_EQ(out, &a);
+
+    // Many consumers on one thread, none of them parking it
+    constexpr std::size_t kConsumers = 12;
+    std::vector<Container *> outs(kConsumers, nullptr);
+    std::vector<Status> statuses(kConsumers, Status::Empty);
+    std::vector<Task> tasks;
+    for (std::size_t i = 0; i < kConsumers; ++i)
+    {
+        tasks.push_back(AsyncPop(q, outs[i], statuses[i]));
+        EXPECT_FALSE(tasks.back().done());
+    }
+
+    std::vector<Container> containers;
+    for (uint16_t i = 0; i < kConsumers; ++i)
+    {
+        containers.emplace_back(i);
+    }
+    for (std::size_t i = 0; i < kConsumers; ++i)
+    {
+        EXPECT_EQ(q.push(containers[i]), Status::Ok);
+        EXPECT_TRUE(tasks[i].done());
+        EXPECT_EQ(statuses[i], Status::Ok);
+        EXPECT_EQ(outs[i], &containers[i]);
+        // The element went straight to the waiter and never showed up in the queue
+        EXPECT_TRUE(q.empty());
+    }
+
+    // A batch push serves only as many waiters as there are elements
+    Container *o1 = nullptr, *o2 = nullptr;
+    Status s1 = Status::Empty, s2 = Status::Empty;
+    auto t1 = AsyncPop(q, o1, s1);
+    auto t2 = AsyncPop(q, o2, s2);
+    std::array<Container *, 1> batch{&b};
+    EXPECT_EQ(q.push_n(batch), 1u);
+    EXPECT_TRUE(t1.done());
+    EXPECT_FALSE(t2.done());
+    EXPECT_EQ(o1, &b);
+    EXPECT_EQ(q.push(a), Status::Ok);
+    EXPECT_TRUE(t2.done());
+    EXPECT_EQ(o2, &a);
+}
+
+// Test that a coroutine pushing to a full queue is resumed by the operation that frees a slot
+TEST(TimeoutQueueTests, AsyncPushBackpressure)
+{
+    SmallTimeoutQueue q(2);
+    Container a(0), b(1), c(2);
+    Container *out = nullptr;
+    EXPECT_EQ(q.push(a), Status::Ok);
+    EXPECT_EQ(q.push(b), Status::Ok);
+
+    Status status = Status::Empty;
+    auto pusher = AsyncPush(q, c, status);
+    EXPECT_FALSE(pusher.done());
+
+    // The invalid ID is only checked once there is room, like push(T &, long)
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(out, &a);
+    EXPECT_TRUE(pusher.done());
+    EXPECT_EQ(status, Status::InvalidId);
+
+    Status again = Status::Empty;
+    auto retry = AsyncPush(q, a, again);
+    EXPECT_TRUE(retry.done());
+    EXPECT_EQ(again, Status::Ok);
+    EXPECT_TRUE(q.full());
+
+    auto queued = AsyncPush(q, a, again);
+    EXPECT_FALSE(queued.done());
+    EXPECT_EQ(q.remove(b), Status::Ok);
+    EXPECT_TRUE(queued.done());
+    // a was still queued once b made room
+    EXPECT_EQ(again, Status::Duplicate);
+    EXPECT_EQ(q.size(), 1u);
+}
+
+// Test that waiters time out through expire_waiters() and that destroyed coroutines leave the waiter list
+TEST(TimeoutQueueTests, AsyncWaiterDeadlinesAndCancellation)
+{
+    SmallTimeoutQueue q;
+    Container a(1);
+    Container *out = nullptr;
+    Status status = Status::Ok;
+
+    auto timed = AsyncPopUntil(q, out, status, 10);
+    EXPECT_EQ(q.expire_waiters(9), 0u);
+    EXPECT_FALSE(timed.done());
+    EXPECT_EQ(q.expire_waiters(10), 1u);
+    EXPECT_TRUE(timed.done());
+    EXPECT_EQ(status, Status::Timeout);
+
+    {
+        Container *lost = nullptr;
+        Status unused = Status::Ok;
+        auto abandoned = AsyncPop(q, lost, unused);
+        EXPECT_FALSE(abandoned.done());
+    }
+    // Nobody is waiting any more, so the element stays queued
+    EXPECT_EQ(q.push(a), Status::Ok);
+    EXPECT_EQ(q.size(), 1u);
+    EXPECT_EQ(q.pop(out), Status::Ok);
+    EXPECT_EQ(out, &a);
+}
+
+// Test that drain and remove_if cancel the deadlines of the elements they take out
+TEST(TimeoutQueueTests, DrainCancelsDeadlines)
+{
+    DeadlineTimeoutQueue q;
+    Container a(1), b(2), c(3);
+    EXPECT_EQ(q.push(a, fcp::Deadline{10}), Status::Ok);
+    EXPECT_EQ(q.push(b, fcp::Deadline{10}), Status::Ok);
+    EXPECT_EQ(q.remove_if([](Container const &x) { return x.GetId() == 1; }), 1u);
+    EXPECT_EQ(q.drain([](Container &) {}), 1u);
+
+    // Re-pushed without a deadline, so nothing may expire
+    EXPECT_EQ(q.push(a), Status::Ok);
+    EXPECT_EQ(q.push(c, fcp::Deadline{20}), Status::Ok);
+    Container *out = nullptr;
+    EXPECT_EQ(q.pop_expired(15, out), Status::Empty);
+    EXPECT_EQ(q.pop_expired(20, out), Status::Ok);
+    EXPECT_EQ(out, &c);
+    EXPECT_EQ(q.size(), 1u);
+}
+
 // Test queue behavior with random removal
 TEST_F(TimeoutQueueTest, RandomRemoval)
 {